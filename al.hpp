@@ -44,6 +44,23 @@
 #include <sstream>
 #include <vector>
 #include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <functional>
+#include <cstring>
+#include <limits>
+#include <bitset>
+#include <cctype>
+#include <iterator>
+#include <fstream>
 
 #if 17 <= AL_HPP_CPP_VERSION
 #include <filesystem>
@@ -95,10 +112,45 @@ extern "C" __declspec( dllimport ) FARPROC __stdcall GetProcAddress( HINSTANCE h
 #    define AL_HPP_SECONDARY_LIBRARY_NAME "soft_oal.dll"
 #endif
 
+// read-only file mapping, used by the mapped_buffer
+#if defined( __unix__ ) || defined( __APPLE__ ) || defined( __QNXNTO__ ) || defined( __Fuchsia__ )
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <fcntl.h>
+#    include <unistd.h>
+#    define AL_HPP_HAS_FILE_MAPPING
+#elif defined( _WIN32 )
+typedef void * HANDLE;
+extern "C" __declspec( dllimport ) HANDLE __stdcall CreateFileA( char const * lpFileName, unsigned long dwDesiredAccess, unsigned long dwShareMode,
+                                                                 struct _SECURITY_ATTRIBUTES * lpSecurityAttributes, unsigned long dwCreationDisposition,
+                                                                 unsigned long dwFlagsAndAttributes, HANDLE hTemplateFile );
+extern "C" __declspec( dllimport ) HANDLE __stdcall CreateFileW( wchar_t const * lpFileName, unsigned long dwDesiredAccess, unsigned long dwShareMode,
+                                                                 struct _SECURITY_ATTRIBUTES * lpSecurityAttributes, unsigned long dwCreationDisposition,
+                                                                 unsigned long dwFlagsAndAttributes, HANDLE hTemplateFile );
+extern "C" __declspec( dllimport ) unsigned long __stdcall GetFileSize( HANDLE hFile, unsigned long * lpFileSizeHigh );
+extern "C" __declspec( dllimport ) HANDLE __stdcall CreateFileMappingA( HANDLE hFile, struct _SECURITY_ATTRIBUTES * lpFileMappingAttributes, unsigned long flProtect,
+                                                                        unsigned long dwMaximumSizeHigh, unsigned long dwMaximumSizeLow, char const * lpName );
+extern "C" __declspec( dllimport ) void * __stdcall MapViewOfFile( HANDLE hFileMappingObject, unsigned long dwDesiredAccess, unsigned long dwFileOffsetHigh,
+                                                                   unsigned long dwFileOffsetLow, size_t dwNumberOfBytesToMap );
+extern "C" __declspec( dllimport ) int __stdcall UnmapViewOfFile( void const * lpBaseAddress );
+extern "C" __declspec( dllimport ) int __stdcall CloseHandle( HANDLE hObject );
+#    define AL_HPP_HAS_FILE_MAPPING
+#endif
+
 
 
-#define AL_NO_PROTOTYPES
-#define ALC_NO_PROTOTYPES
+// with AL_HPP_STATIC_DISPATCH defined, core and EFX functions are called directly through the prototypes of a
+// statically linked OpenAL, so the compiler can inline them; extension functions are still loaded at runtime.
+// This puts the prototypes into the global namespace.
+#if defined( AL_HPP_STATIC_DISPATCH )
+#  if defined( AL_HPP_INSTRUMENT )
+#    error "AL_HPP_STATIC_DISPATCH can't be combined with AL_HPP_INSTRUMENT, which swaps the function pointers at runtime"
+#  endif
+#  define AL_ALEXT_PROTOTYPES
+#else
+#  define AL_NO_PROTOTYPES
+#  define ALC_NO_PROTOTYPES
+#endif
 #include <AL/alext.h>
 #include <AL/efx-presets.h>
 
@@ -130,6 +182,11 @@ extern "C" __declspec( dllimport ) FARPROC __stdcall GetProcAddress( HINSTANCE h
 #  define __has_include( x ) false
 #endif
 
+// the __cpp_lib_ feature macros below are only guaranteed to be defined once <version> is included
+#if __has_include( <version> )
+#  include <version>
+#endif
+
 #if ( 201907 <= __cpp_lib_three_way_comparison ) && __has_include( <compare> ) && !defined( AL_HPP_NO_SPACESHIP_OPERATOR )
 #  define AL_HPP_HAS_SPACESHIP_OPERATOR
 #endif
@@ -142,6 +199,27 @@ extern "C" __declspec( dllimport ) FARPROC __stdcall GetProcAddress( HINSTANCE h
 #  include <span>
 #endif
 
+// instruction sets for the sample conversion kernels, chosen at compile time (e.g. -mavx2); AL_HPP_NO_SIMD forces the scalar code
+#if !defined( AL_HPP_NO_SIMD )
+#  if defined( __AVX2__ )
+#    define AL_HPP_SIMD_AVX2
+#  endif
+#  if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && 2 <= _M_IX86_FP )
+#    define AL_HPP_SIMD_SSE2
+#  endif
+#  if defined( __ARM_NEON ) && ( defined( __aarch64__ ) || defined( _M_ARM64 ) )
+#    define AL_HPP_SIMD_NEON
+#  endif
+#endif
+#if defined( AL_HPP_SIMD_AVX2 )
+#  include <immintrin.h>
+#elif defined( AL_HPP_SIMD_SSE2 )
+#  include <emmintrin.h>
+#endif
+#if defined( AL_HPP_SIMD_NEON )
+#  include <arm_neon.h>
+#endif
+
 
 
 #if !defined( AL_HPP_HAS_UNRESTRICTED_UNIONS )
@@ -225,6 +303,12 @@ extern "C" __declspec( dllimport ) FARPROC __stdcall GetProcAddress( HINSTANCE h
 #  define AL_HPP_DEPRECATED( msg )
 #endif
 
+#if 17 <= AL_HPP_CPP_VERSION
+#  define AL_HPP_INLINE_VARIABLE inline
+#else
+#  define AL_HPP_INLINE_VARIABLE
+#endif
+
 #if ( 17 <= AL_HPP_CPP_VERSION ) && !defined( AL_HPP_NO_NODISCARD_WARNINGS )
 #  define AL_HPP_NODISCARD [[nodiscard]]
 #  if defined( AL_HPP_NO_EXCEPTIONS )
@@ -243,203 +327,297 @@ extern "C" __declspec( dllimport ) FARPROC __stdcall GetProcAddress( HINSTANCE h
 
 
 // function pointer declarations
+// Every entry point is listed once as X(namespace, pointer type, name, exported symbol, extension), extension being nullptr for core functions.
+// The exported symbol is the bare identifier, so it can be stringized for loading or taken the address of for static dispatch.
+// The lists get expanded into the declarations below, and wherever else all entry points have to be handled the same way.
+
+// Core ALC functions
+#define AL_HPP_CORE_ALC_FUNCTIONS(X) \
+    X(alc, LPALCCREATECONTEXT     , createContext     , alcCreateContext       , nullptr) \
+    X(alc, LPALCMAKECONTEXTCURRENT, makeContextCurrent, alcMakeContextCurrent  , nullptr) \
+    X(alc, LPALCPROCESSCONTEXT    , processContext    , alcProcessContext      , nullptr) \
+    X(alc, LPALCSUSPENDCONTEXT    , suspendContext    , alcSuspendContext      , nullptr) \
+    X(alc, LPALCDESTROYCONTEXT    , destroyContext    , alcDestroyContext      , nullptr) \
+    X(alc, LPALCGETCURRENTCONTEXT , getCurrentContext , alcGetCurrentContext   , nullptr) \
+    X(alc, LPALCGETCONTEXTSDEVICE , getContextsDevice , alcGetContextsDevice   , nullptr) \
+    X(alc, LPALCOPENDEVICE        , openDevice        , alcOpenDevice          , nullptr) \
+    X(alc, LPALCCLOSEDEVICE       , closeDevice       , alcCloseDevice         , nullptr) \
+    X(alc, LPALCGETERROR          , getError          , alcGetError            , nullptr) \
+    X(alc, LPALCISEXTENSIONPRESENT, isExtensionPresent, alcIsExtensionPresent  , nullptr) \
+    X(alc, LPALCGETPROCADDRESS    , getProcAddress    , alcGetProcAddress      , nullptr) \
+    X(alc, LPALCGETENUMVALUE      , getEnumValue      , alcGetEnumValue        , nullptr) \
+    X(alc, LPALCGETSTRING         , getString         , alcGetString           , nullptr) \
+    X(alc, LPALCGETINTEGERV       , getIntegerv       , alcGetIntegerv         , nullptr) \
+    X(alc, LPALCCAPTUREOPENDEVICE , captureOpenDevice , alcCaptureOpenDevice   , nullptr) \
+    X(alc, LPALCCAPTURECLOSEDEVICE, captureCloseDevice, alcCaptureCloseDevice  , nullptr) \
+    X(alc, LPALCCAPTURESTART      , captureStart      , alcCaptureStart        , nullptr) \
+    X(alc, LPALCCAPTURESTOP       , captureStop       , alcCaptureStop         , nullptr) \
+    X(alc, LPALCCAPTURESAMPLES    , captureSamples    , alcCaptureSamples      , nullptr)
+
+// ALC extension functions, loaded with alcGetProcAddress
+#define AL_HPP_ALC_EXTENSION_FUNCTIONS(X) \
+    /* ALC_EXT_thread_local_context */ \
+    X(alc, PFNALCSETTHREADCONTEXTPROC      , setThreadContext           , alcSetThreadContext             , "ALC_EXT_thread_local_context") \
+    X(alc, PFNALCGETTHREADCONTEXTPROC      , getThreadContext           , alcGetThreadContext             , "ALC_EXT_thread_local_context") \
+    /* ALC_SOFT_loopback */ \
+    X(alc, LPALCLOOPBACKOPENDEVICESOFT     , loopbackOpenDeviceSOFT     , alcLoopbackOpenDeviceSOFT       , "ALC_SOFT_loopback") \
+    X(alc, LPALCISRENDERFORMATSUPPORTEDSOFT, isRenderFormatSupportedSOFT, alcIsRenderFormatSupportedSOFT  , "ALC_SOFT_loopback") \
+    X(alc, LPALCRENDERSAMPLESSOFT          , renderSamplesSOFT          , alcRenderSamplesSOFT            , "ALC_SOFT_loopback") \
+    /* ALC_SOFT_pause_device */ \
+    X(alc, LPALCDEVICEPAUSESOFT            , devicePauseSOFT            , alcDevicePauseSOFT              , "ALC_SOFT_pause_device") \
+    X(alc, LPALCDEVICERESUMESOFT           , deviceResumeSOFT           , alcDeviceResumeSOFT             , "ALC_SOFT_pause_device") \
+    /* ALC_SOFT_HRTF */ \
+    X(alc, LPALCGETSTRINGISOFT             , getStringiSOFT             , alcGetStringiSOFT               , "ALC_SOFT_HRTF") \
+    X(alc, LPALCRESETDEVICESOFT            , resetDeviceSOFT            , alcResetDeviceSOFT              , "ALC_SOFT_HRTF") \
+    /* ALC_SOFT_device_clock */ \
+    X(alc, LPALCGETINTEGER64VSOFT          , getInteger64vSOFT          , alcGetInteger64vSOFT            , "ALC_SOFT_device_clock") \
+    /* ALC_SOFT_reopen_device */ \
+    X(alc, LPALCREOPENDEVICESOFT           , reopenDeviceSOFT           , alcReopenDeviceSOFT             , "ALC_SOFT_reopen_device")
+
+// Core AL functions
+#define AL_HPP_CORE_AL_FUNCTIONS(X) \
+    X(al , LPALDOPPLERFACTOR       , dopplerFactor       , alDopplerFactor         , nullptr) \
+    X(al , LPALDOPPLERVELOCITY     , dopplerVelocity     , alDopplerVelocity       , nullptr) \
+    X(al , LPALSPEEDOFSOUND        , speedOfSound        , alSpeedOfSound          , nullptr) \
+    X(al , LPALDISTANCEMODEL       , distanceModel       , alDistanceModel         , nullptr) \
+    X(al , LPALENABLE              , enable              , alEnable                , nullptr) \
+    X(al , LPALDISABLE             , disable             , alDisable               , nullptr) \
+    X(al , LPALISENABLED           , isEnabled           , alIsEnabled             , nullptr) \
+    X(al , LPALGETSTRING           , getString           , alGetString             , nullptr) \
+    X(al , LPALGETBOOLEANV         , getBooleanv         , alGetBooleanv           , nullptr) \
+    X(al , LPALGETINTEGERV         , getIntegerv         , alGetIntegerv           , nullptr) \
+    X(al , LPALGETFLOATV           , getFloatv           , alGetFloatv             , nullptr) \
+    X(al , LPALGETDOUBLEV          , getDoublev          , alGetDoublev            , nullptr) \
+    X(al , LPALGETBOOLEAN          , getBoolean          , alGetBoolean            , nullptr) \
+    X(al , LPALGETINTEGER          , getInteger          , alGetInteger            , nullptr) \
+    X(al , LPALGETFLOAT            , getFloat            , alGetFloat              , nullptr) \
+    X(al , LPALGETDOUBLE           , getDouble           , alGetDouble             , nullptr) \
+    X(al , LPALGETERROR            , getError            , alGetError              , nullptr) \
+    X(al , LPALISEXTENSIONPRESENT  , isExtensionPresent  , alIsExtensionPresent    , nullptr) \
+    X(al , LPALGETPROCADDRESS      , getProcAddress      , alGetProcAddress        , nullptr) \
+    X(al , LPALGETENUMVALUE        , getEnumValue        , alGetEnumValue          , nullptr) \
+    X(al , LPALLISTENERF           , listenerf           , alListenerf             , nullptr) \
+    X(al , LPALLISTENER3F          , listener3f          , alListener3f            , nullptr) \
+    X(al , LPALLISTENERFV          , listenerfv          , alListenerfv            , nullptr) \
+    X(al , LPALLISTENERI           , listeneri           , alListeneri             , nullptr) \
+    X(al , LPALLISTENER3I          , listener3i          , alListener3i            , nullptr) \
+    X(al , LPALLISTENERIV          , listeneriv          , alListeneriv            , nullptr) \
+    X(al , LPALGETLISTENERF        , getListenerf        , alGetListenerf          , nullptr) \
+    X(al , LPALGETLISTENER3F       , getListener3f       , alGetListener3f         , nullptr) \
+    X(al , LPALGETLISTENERFV       , getListenerfv       , alGetListenerfv         , nullptr) \
+    X(al , LPALGETLISTENERI        , getListeneri        , alGetListeneri          , nullptr) \
+    X(al , LPALGETLISTENER3I       , getListener3i       , alGetListener3i         , nullptr) \
+    X(al , LPALGETLISTENERIV       , getListeneriv       , alGetListeneriv         , nullptr) \
+    X(al , LPALGENSOURCES          , genSources          , alGenSources            , nullptr) \
+    X(al , LPALDELETESOURCES       , deleteSources       , alDeleteSources         , nullptr) \
+    X(al , LPALISSOURCE            , isSource            , alIsSource              , nullptr) \
+    X(al , LPALSOURCEF             , sourcef             , alSourcef               , nullptr) \
+    X(al , LPALSOURCE3F            , source3f            , alSource3f              , nullptr) \
+    X(al , LPALSOURCEFV            , sourcefv            , alSourcefv              , nullptr) \
+    X(al , LPALSOURCEI             , sourcei             , alSourcei               , nullptr) \
+    X(al , LPALSOURCE3I            , source3i            , alSource3i              , nullptr) \
+    X(al , LPALSOURCEIV            , sourceiv            , alSourceiv              , nullptr) \
+    X(al , LPALGETSOURCEF          , getSourcef          , alGetSourcef            , nullptr) \
+    X(al , LPALGETSOURCE3F         , getSource3f         , alGetSource3f           , nullptr) \
+    X(al , LPALGETSOURCEFV         , getSourcefv         , alGetSourcefv           , nullptr) \
+    X(al , LPALGETSOURCEI          , getSourcei          , alGetSourcei            , nullptr) \
+    X(al , LPALGETSOURCE3I         , getSource3i         , alGetSource3i           , nullptr) \
+    X(al , LPALGETSOURCEIV         , getSourceiv         , alGetSourceiv           , nullptr) \
+    X(al , LPALSOURCEPLAYV         , sourcePlayv         , alSourcePlayv           , nullptr) \
+    X(al , LPALSOURCESTOPV         , sourceStopv         , alSourceStopv           , nullptr) \
+    X(al , LPALSOURCEREWINDV       , sourceRewindv       , alSourceRewindv         , nullptr) \
+    X(al , LPALSOURCEPAUSEV        , sourcePausev        , alSourcePausev          , nullptr) \
+    X(al , LPALSOURCEPLAY          , sourcePlay          , alSourcePlay            , nullptr) \
+    X(al , LPALSOURCESTOP          , sourceStop          , alSourceStop            , nullptr) \
+    X(al , LPALSOURCEREWIND        , sourceRewind        , alSourceRewind          , nullptr) \
+    X(al , LPALSOURCEPAUSE         , sourcePause         , alSourcePause           , nullptr) \
+    X(al , LPALSOURCEQUEUEBUFFERS  , sourceQueueBuffers  , alSourceQueueBuffers    , nullptr) \
+    X(al , LPALSOURCEUNQUEUEBUFFERS, sourceUnqueueBuffers, alSourceUnqueueBuffers  , nullptr) \
+    X(al , LPALGENBUFFERS          , genBuffers          , alGenBuffers            , nullptr) \
+    X(al , LPALDELETEBUFFERS       , deleteBuffers       , alDeleteBuffers         , nullptr) \
+    X(al , LPALISBUFFER            , isBuffer            , alIsBuffer              , nullptr) \
+    X(al , LPALBUFFERDATA          , bufferData          , alBufferData            , nullptr) \
+    X(al , LPALBUFFERF             , bufferf             , alBufferf               , nullptr) \
+    X(al , LPALBUFFER3F            , buffer3f            , alBuffer3f              , nullptr) \
+    X(al , LPALBUFFERFV            , bufferfv            , alBufferfv              , nullptr) \
+    X(al , LPALBUFFERI             , bufferi             , alBufferi               , nullptr) \
+    X(al , LPALBUFFER3I            , buffer3i            , alBuffer3i              , nullptr) \
+    X(al , LPALBUFFERIV            , bufferiv            , alBufferiv              , nullptr) \
+    X(al , LPALGETBUFFERF          , getBufferf          , alGetBufferf            , nullptr) \
+    X(al , LPALGETBUFFER3F         , getBuffer3f         , alGetBuffer3f           , nullptr) \
+    X(al , LPALGETBUFFERFV         , getBufferfv         , alGetBufferfv           , nullptr) \
+    X(al , LPALGETBUFFERI          , getBufferi          , alGetBufferi            , nullptr) \
+    X(al , LPALGETBUFFER3I         , getBuffer3i         , alGetBuffer3i           , nullptr) \
+    X(al , LPALGETBUFFERIV         , getBufferiv         , alGetBufferiv           , nullptr)
+
+// EFX functions, loaded with alGetProcAddress
+#define AL_HPP_EFX_FUNCTIONS(X) \
+    X(al , LPALGENEFFECTS                , genEffects                , alGenEffects                  , "ALC_EXT_EFX") \
+    X(al , LPALDELETEEFFECTS             , deleteEffects             , alDeleteEffects               , "ALC_EXT_EFX") \
+    X(al , LPALISEFFECT                  , isEffect                  , alIsEffect                    , "ALC_EXT_EFX") \
+    X(al , LPALEFFECTI                   , effecti                   , alEffecti                     , "ALC_EXT_EFX") \
+    X(al , LPALEFFECTIV                  , effectiv                  , alEffectiv                    , "ALC_EXT_EFX") \
+    X(al , LPALEFFECTF                   , effectf                   , alEffectf                     , "ALC_EXT_EFX") \
+    X(al , LPALEFFECTFV                  , effectfv                  , alEffectfv                    , "ALC_EXT_EFX") \
+    X(al , LPALGETEFFECTI                , getEffecti                , alGetEffecti                  , "ALC_EXT_EFX") \
+    X(al , LPALGETEFFECTIV               , getEffectiv               , alGetEffectiv                 , "ALC_EXT_EFX") \
+    X(al , LPALGETEFFECTF                , getEffectf                , alGetEffectf                  , "ALC_EXT_EFX") \
+    X(al , LPALGETEFFECTFV               , getEffectfv               , alGetEffectfv                 , "ALC_EXT_EFX") \
+    X(al , LPALGENFILTERS                , genFilters                , alGenFilters                  , "ALC_EXT_EFX") \
+    X(al , LPALDELETEFILTERS             , deleteFilters             , alDeleteFilters               , "ALC_EXT_EFX") \
+    X(al , LPALISFILTER                  , isFilter                  , alIsFilter                    , "ALC_EXT_EFX") \
+    X(al , LPALFILTERI                   , filteri                   , alFilteri                     , "ALC_EXT_EFX") \
+    X(al , LPALFILTERIV                  , filteriv                  , alFilteriv                    , "ALC_EXT_EFX") \
+    X(al , LPALFILTERF                   , filterf                   , alFilterf                     , "ALC_EXT_EFX") \
+    X(al , LPALFILTERFV                  , filterfv                  , alFilterfv                    , "ALC_EXT_EFX") \
+    X(al , LPALGETFILTERI                , getFilteri                , alGetFilteri                  , "ALC_EXT_EFX") \
+    X(al , LPALGETFILTERIV               , getFilteriv               , alGetFilteriv                 , "ALC_EXT_EFX") \
+    X(al , LPALGETFILTERF                , getFilterf                , alGetFilterf                  , "ALC_EXT_EFX") \
+    X(al , LPALGETFILTERFV               , getFilterfv               , alGetFilterfv                 , "ALC_EXT_EFX") \
+    X(al , LPALGENAUXILIARYEFFECTSLOTS   , genAuxiliaryEffectSlots   , alGenAuxiliaryEffectSlots     , "ALC_EXT_EFX") \
+    X(al , LPALDELETEAUXILIARYEFFECTSLOTS, deleteAuxiliaryEffectSlots, alDeleteAuxiliaryEffectSlots  , "ALC_EXT_EFX") \
+    X(al , LPALISAUXILIARYEFFECTSLOT     , isAuxiliaryEffectSlot     , alIsAuxiliaryEffectSlot       , "ALC_EXT_EFX") \
+    X(al , LPALAUXILIARYEFFECTSLOTI      , auxiliaryEffectSloti      , alAuxiliaryEffectSloti        , "ALC_EXT_EFX") \
+    X(al , LPALAUXILIARYEFFECTSLOTIV     , auxiliaryEffectSlotiv     , alAuxiliaryEffectSlotiv       , "ALC_EXT_EFX") \
+    X(al , LPALAUXILIARYEFFECTSLOTF      , auxiliaryEffectSlotf      , alAuxiliaryEffectSlotf        , "ALC_EXT_EFX") \
+    X(al , LPALAUXILIARYEFFECTSLOTFV     , auxiliaryEffectSlotfv     , alAuxiliaryEffectSlotfv       , "ALC_EXT_EFX") \
+    X(al , LPALGETAUXILIARYEFFECTSLOTI   , getAuxiliaryEffectSloti   , alGetAuxiliaryEffectSloti     , "ALC_EXT_EFX") \
+    X(al , LPALGETAUXILIARYEFFECTSLOTIV  , getAuxiliaryEffectSlotiv  , alGetAuxiliaryEffectSlotiv    , "ALC_EXT_EFX") \
+    X(al , LPALGETAUXILIARYEFFECTSLOTF   , getAuxiliaryEffectSlotf   , alGetAuxiliaryEffectSlotf     , "ALC_EXT_EFX") \
+    X(al , LPALGETAUXILIARYEFFECTSLOTFV  , getAuxiliaryEffectSlotfv  , alGetAuxiliaryEffectSlotfv    , "ALC_EXT_EFX")
+
+// AL extension functions, loaded with alGetProcAddress
+#define AL_HPP_AL_EXTENSION_FUNCTIONS(X) \
+    /* AL_EXT_STATIC_BUFFER */ \
+    X(al , PFNALBUFFERDATASTATICPROC      , bufferDataStatic           , alBufferDataStatic             , "AL_EXT_STATIC_BUFFER") \
+    /* AL_SOFT_buffer_sub_data */ \
+    X(al , PFNALBUFFERSUBDATASOFTPROC     , bufferSubDataSOFT          , alBufferSubDataSOFT            , "AL_SOFT_buffer_sub_data") \
+    /* AL_EXT_FOLDBACK */ \
+    X(al , LPALREQUESTFOLDBACKSTART       , requestFoldbackStart       , alRequestFoldbackStart         , "AL_EXT_FOLDBACK") \
+    X(al , LPALREQUESTFOLDBACKSTOP        , requestFoldbackStop        , alRequestFoldbackStop          , "AL_EXT_FOLDBACK") \
+    /* AL_SOFT_buffer_samples */ \
+    X(al , LPALBUFFERSAMPLESSOFT          , bufferSamplesSOFT          , alBufferSamplesSOFT            , "AL_SOFT_buffer_samples") \
+    X(al , LPALBUFFERSUBSAMPLESSOFT       , bufferSubSamplesSOFT       , alBufferSubSamplesSOFT         , "AL_SOFT_buffer_samples") \
+    X(al , LPALGETBUFFERSAMPLESSOFT       , getBufferSamplesSOFT       , alGetBufferSamplesSOFT         , "AL_SOFT_buffer_samples") \
+    X(al , LPALISBUFFERFORMATSUPPORTEDSOFT, isBufferFormatSupportedSOFT, alIsBufferFormatSupportedSOFT  , "AL_SOFT_buffer_samples") \
+    /* AL_SOFT_source_latency */ \
+    X(al , LPALSOURCEDSOFT                , sourcedSOFT                , alSourcedSOFT                  , "AL_SOFT_source_latency") \
+    X(al , LPALSOURCE3DSOFT               , source3dSOFT               , alSource3dSOFT                 , "AL_SOFT_source_latency") \
+    X(al , LPALSOURCEDVSOFT               , sourcedvSOFT               , alSourcedvSOFT                 , "AL_SOFT_source_latency") \
+    X(al , LPALGETSOURCEDSOFT             , getSourcedSOFT             , alGetSourcedSOFT               , "AL_SOFT_source_latency") \
+    X(al , LPALGETSOURCE3DSOFT            , getSource3dSOFT            , alGetSource3dSOFT              , "AL_SOFT_source_latency") \
+    X(al , LPALGETSOURCEDVSOFT            , getSourcedvSOFT            , alGetSourcedvSOFT              , "AL_SOFT_source_latency") \
+    X(al , LPALSOURCEI64SOFT              , sourcei64SOFT              , alSourcei64SOFT                , "AL_SOFT_source_latency") \
+    X(al , LPALSOURCE3I64SOFT             , source3i64SOFT             , alSource3i64SOFT               , "AL_SOFT_source_latency") \
+    X(al , LPALSOURCEI64VSOFT             , sourcei64vSOFT             , alSourcei64vSOFT               , "AL_SOFT_source_latency") \
+    X(al , LPALGETSOURCEI64SOFT           , getSourcei64SOFT           , alGetSourcei64SOFT             , "AL_SOFT_source_latency") \
+    X(al , LPALGETSOURCE3I64SOFT          , getSource3i64SOFT          , alGetSource3i64SOFT            , "AL_SOFT_source_latency") \
+    X(al , LPALGETSOURCEI64VSOFT          , getSourcei64vSOFT          , alGetSourcei64vSOFT            , "AL_SOFT_source_latency") \
+    /* AL_SOFT_deferred_updates */ \
+    X(al , LPALDEFERUPDATESSOFT           , deferUpdatesSOFT           , alDeferUpdatesSOFT             , "AL_SOFT_deferred_updates") \
+    X(al , LPALPROCESSUPDATESSOFT         , processUpdatesSOFT         , alProcessUpdatesSOFT           , "AL_SOFT_deferred_updates") \
+    /* AL_SOFT_source_resampler */ \
+    X(al , LPALGETSTRINGISOFT             , getStringiSOFT             , alGetStringiSOFT               , "AL_SOFT_source_resampler") \
+    /* AL_SOFT_events */ \
+    X(al , LPALEVENTCONTROLSOFT           , eventControlSOFT           , alEventControlSOFT             , "AL_SOFT_events") \
+    X(al , LPALEVENTCALLBACKSOFT          , eventCallbackSOFT          , alEventCallbackSOFT            , "AL_SOFT_events") \
+    X(al , LPALGETPOINTERSOFT             , getPointerSOFT             , alGetPointerSOFT               , "AL_SOFT_events") \
+    X(al , LPALGETPOINTERVSOFT            , getPointervSOFT            , alGetPointervSOFT              , "AL_SOFT_events") \
+    /* AL_SOFT_callback_buffer */ \
+    X(al , LPALBUFFERCALLBACKSOFT         , bufferCallbackSOFT         , alBufferCallbackSOFT           , "AL_SOFT_callback_buffer") \
+    X(al , LPALGETBUFFERPTRSOFT           , getBufferPtrSOFT           , alGetBufferPtrSOFT             , "AL_SOFT_callback_buffer") \
+    X(al , LPALGETBUFFER3PTRSOFT          , getBuffer3PtrSOFT          , alGetBuffer3PtrSOFT            , "AL_SOFT_callback_buffer") \
+    X(al , LPALGETBUFFERPTRVSOFT          , getBufferPtrvSOFT          , alGetBufferPtrvSOFT            , "AL_SOFT_callback_buffer")
+
+#define AL_HPP_DECLARE_FUNCTION_POINTER(space, type, name, symbol, extension) type name = nullptr;
+#if defined( AL_HPP_STATIC_DISPATCH )
+#  define AL_HPP_DECLARE_CORE_FUNCTION_POINTER(space, type, name, symbol, extension) AL_HPP_CONST_OR_CONSTEXPR type name = &::symbol;
+#else
+#  define AL_HPP_DECLARE_CORE_FUNCTION_POINTER AL_HPP_DECLARE_FUNCTION_POINTER
+#endif
+
 namespace alc {
     // Core ALC function pointers
-    LPALCCREATECONTEXT               createContext               = nullptr;
-    LPALCMAKECONTEXTCURRENT          makeContextCurrent          = nullptr;
-    LPALCPROCESSCONTEXT              processContext              = nullptr;
-    LPALCSUSPENDCONTEXT              suspendContext              = nullptr;
-    LPALCDESTROYCONTEXT              destroyContext              = nullptr;
-    LPALCGETCURRENTCONTEXT           getCurrentContext           = nullptr;
-    LPALCGETCONTEXTSDEVICE           getContextsDevice           = nullptr;
-    LPALCOPENDEVICE                  openDevice                  = nullptr;
-    LPALCCLOSEDEVICE                 closeDevice                 = nullptr;
-    LPALCGETERROR                    getError                    = nullptr;
-    LPALCISEXTENSIONPRESENT          isExtensionPresent          = nullptr;
-    LPALCGETPROCADDRESS              getProcAddress              = nullptr;
-    LPALCGETENUMVALUE                getEnumValue                = nullptr;
-    LPALCGETSTRING                   getString                   = nullptr;
-    LPALCGETINTEGERV                 getIntegerv                 = nullptr;
-    LPALCCAPTUREOPENDEVICE           captureOpenDevice           = nullptr;
-    LPALCCAPTURECLOSEDEVICE          captureCloseDevice          = nullptr;
-    LPALCCAPTURESTART                captureStart                = nullptr;
-    LPALCCAPTURESTOP                 captureStop                 = nullptr;
-    LPALCCAPTURESAMPLES              captureSamples              = nullptr;
+    AL_HPP_CORE_ALC_FUNCTIONS(AL_HPP_DECLARE_CORE_FUNCTION_POINTER)
 
     // ALC extension function pointers
-    //ALC_EXT_thread_local_context
-    PFNALCSETTHREADCONTEXTPROC       setThreadContext            = nullptr;
-    PFNALCGETTHREADCONTEXTPROC       getThreadContext            = nullptr;
-    //ALC_SOFT_loopback
-    LPALCLOOPBACKOPENDEVICESOFT      loopbackOpenDeviceSOFT      = nullptr;
-    LPALCISRENDERFORMATSUPPORTEDSOFT isRenderFormatSupportedSOFT = nullptr;
-    LPALCRENDERSAMPLESSOFT           renderSamplesSOFT           = nullptr;
-    //ALC_SOFT_pause_device
-    LPALCDEVICEPAUSESOFT             devicePauseSOFT             = nullptr;
-    LPALCDEVICERESUMESOFT            deviceResumeSOFT            = nullptr;
-    //ALC_SOFT_HRTF
-    LPALCGETSTRINGISOFT              getStringiSOFT              = nullptr;
-    LPALCRESETDEVICESOFT             resetDeviceSOFT             = nullptr;
-    //ALC_SOFT_device_clock
-    LPALCGETINTEGER64VSOFT           getInteger64vSOFT           = nullptr;
-    //ALC_SOFT_reopen_device
-    LPALCREOPENDEVICESOFT            reopenDeviceSOFT            = nullptr;
+    AL_HPP_ALC_EXTENSION_FUNCTIONS(AL_HPP_DECLARE_FUNCTION_POINTER)
 }
 namespace al {
     // Core AL function pointers
-    LPALDOPPLERFACTOR                dopplerFactor               = nullptr;
-    LPALDOPPLERVELOCITY              dopplerVelocity             = nullptr;
-    LPALSPEEDOFSOUND                 speedOfSound                = nullptr;
-    LPALDISTANCEMODEL                distanceModel               = nullptr;
-    LPALENABLE                       enable                      = nullptr;
-    LPALDISABLE                      disable                     = nullptr;
-    LPALISENABLED                    isEnabled                   = nullptr;
-    LPALGETSTRING                    getString                   = nullptr;
-    LPALGETBOOLEANV                  getBooleanv                 = nullptr;
-    LPALGETINTEGERV                  getIntegerv                 = nullptr;
-    LPALGETFLOATV                    getFloatv                   = nullptr;
-    LPALGETDOUBLEV                   getDoublev                  = nullptr;
-    LPALGETBOOLEAN                   getBoolean                  = nullptr;
-    LPALGETINTEGER                   getInteger                  = nullptr;
-    LPALGETFLOAT                     getFloat                    = nullptr;
-    LPALGETDOUBLE                    getDouble                   = nullptr;
-    LPALGETERROR                     getError                    = nullptr;
-    LPALISEXTENSIONPRESENT           isExtensionPresent          = nullptr;
-    LPALGETPROCADDRESS               getProcAddress              = nullptr;
-    LPALGETENUMVALUE                 getEnumValue                = nullptr;
-    LPALLISTENERF                    listenerf                   = nullptr;
-    LPALLISTENER3F                   listener3f                  = nullptr;
-    LPALLISTENERFV                   listenerfv                  = nullptr;
-    LPALLISTENERI                    listeneri                   = nullptr;
-    LPALLISTENER3I                   listener3i                  = nullptr;
-    LPALLISTENERIV                   listeneriv                  = nullptr;
-    LPALGETLISTENERF                 getListenerf                = nullptr;
-    LPALGETLISTENER3F                getListener3f               = nullptr;
-    LPALGETLISTENERFV                getListenerfv               = nullptr;
-    LPALGETLISTENERI                 getListeneri                = nullptr;
-    LPALGETLISTENER3I                getListener3i               = nullptr;
-    LPALGETLISTENERIV                getListeneriv               = nullptr;
-    LPALGENSOURCES                   genSources                  = nullptr;
-    LPALDELETESOURCES                deleteSources               = nullptr;
-    LPALISSOURCE                     isSource                    = nullptr;
-    LPALSOURCEF                      sourcef                     = nullptr;
-    LPALSOURCE3F                     source3f                    = nullptr;
-    LPALSOURCEFV                     sourcefv                    = nullptr;
-    LPALSOURCEI                      sourcei                     = nullptr;
-    LPALSOURCE3I                     source3i                    = nullptr;
-    LPALSOURCEIV                     sourceiv                    = nullptr;
-    LPALGETSOURCEF                   getSourcef                  = nullptr;
-    LPALGETSOURCE3F                  getSource3f                 = nullptr;
-    LPALGETSOURCEFV                  getSourcefv                 = nullptr;
-    LPALGETSOURCEI                   getSourcei                  = nullptr;
-    LPALGETSOURCE3I                  getSource3i                 = nullptr;
-    LPALGETSOURCEIV                  getSourceiv                 = nullptr;
-    LPALSOURCEPLAYV                  sourcePlayv                 = nullptr;
-    LPALSOURCESTOPV                  sourceStopv                 = nullptr;
-    LPALSOURCEREWINDV                sourceRewindv               = nullptr;
-    LPALSOURCEPAUSEV                 sourcePausev                = nullptr;
-    LPALSOURCEPLAY                   sourcePlay                  = nullptr;
-    LPALSOURCESTOP                   sourceStop                  = nullptr;
-    LPALSOURCEREWIND                 sourceRewind                = nullptr;
-    LPALSOURCEPAUSE                  sourcePause                 = nullptr;
-    LPALSOURCEQUEUEBUFFERS           sourceQueueBuffers          = nullptr;
-    LPALSOURCEUNQUEUEBUFFERS         sourceUnqueueBuffers        = nullptr;
-    LPALGENBUFFERS                   genBuffers                  = nullptr;
-    LPALDELETEBUFFERS                deleteBuffers               = nullptr;
-    LPALISBUFFER                     isBuffer                    = nullptr;
-    LPALBUFFERDATA                   bufferData                  = nullptr;
-    LPALBUFFERF                      bufferf                     = nullptr;
-    LPALBUFFER3F                     buffer3f                    = nullptr;
-    LPALBUFFERFV                     bufferfv                    = nullptr;
-    LPALBUFFERI                      bufferi                     = nullptr;
-    LPALBUFFER3I                     buffer3i                    = nullptr;
-    LPALBUFFERIV                     bufferiv                    = nullptr;
-    LPALGETBUFFERF                   getBufferf                  = nullptr;
-    LPALGETBUFFER3F                  getBuffer3f                 = nullptr;
-    LPALGETBUFFERFV                  getBufferfv                 = nullptr;
-    LPALGETBUFFERI                   getBufferi                  = nullptr;
-    LPALGETBUFFER3I                  getBuffer3i                 = nullptr;
-    LPALGETBUFFERIV                  getBufferiv                 = nullptr;
+    AL_HPP_CORE_AL_FUNCTIONS(AL_HPP_DECLARE_CORE_FUNCTION_POINTER)
 
     // EFX function pointers
-    LPALGENEFFECTS                   genEffects                  = nullptr;
-    LPALDELETEEFFECTS                deleteEffects               = nullptr;
-    LPALISEFFECT                     isEffect                    = nullptr;
-    LPALEFFECTI                      effecti                     = nullptr;
-    LPALEFFECTIV                     effectiv                    = nullptr;
-    LPALEFFECTF                      effectf                     = nullptr;
-    LPALEFFECTFV                     effectfv                    = nullptr;
-    LPALGETEFFECTI                   getEffecti                  = nullptr;
-    LPALGETEFFECTIV                  getEffectiv                 = nullptr;
-    LPALGETEFFECTF                   getEffectf                  = nullptr;
-    LPALGETEFFECTFV                  getEffectfv                 = nullptr;
-    LPALGENFILTERS                   genFilters                  = nullptr;
-    LPALDELETEFILTERS                deleteFilters               = nullptr;
-    LPALISFILTER                     isFilter                    = nullptr;
-    LPALFILTERI                      filteri                     = nullptr;
-    LPALFILTERIV                     filteriv                    = nullptr;
-    LPALFILTERF                      filterf                     = nullptr;
-    LPALFILTERFV                     filterfv                    = nullptr;
-    LPALGETFILTERI                   getFilteri                  = nullptr;
-    LPALGETFILTERIV                  getFilteriv                 = nullptr;
-    LPALGETFILTERF                   getFilterf                  = nullptr;
-    LPALGETFILTERFV                  getFilterfv                 = nullptr;
-    LPALGENAUXILIARYEFFECTSLOTS      genAuxiliaryEffectSlots     = nullptr;
-    LPALDELETEAUXILIARYEFFECTSLOTS   deleteAuxiliaryEffectSlots  = nullptr;
-    LPALISAUXILIARYEFFECTSLOT        isAuxiliaryEffectSlot       = nullptr;
-    LPALAUXILIARYEFFECTSLOTI         auxiliaryEffectSloti        = nullptr;
-    LPALAUXILIARYEFFECTSLOTIV        auxiliaryEffectSlotiv       = nullptr;
-    LPALAUXILIARYEFFECTSLOTF         auxiliaryEffectSlotf        = nullptr;
-    LPALAUXILIARYEFFECTSLOTFV        auxiliaryEffectSlotfv       = nullptr;
-    LPALGETAUXILIARYEFFECTSLOTI      getAuxiliaryEffectSloti     = nullptr;
-    LPALGETAUXILIARYEFFECTSLOTIV     getAuxiliaryEffectSlotiv    = nullptr;
-    LPALGETAUXILIARYEFFECTSLOTF      getAuxiliaryEffectSlotf     = nullptr;
-    LPALGETAUXILIARYEFFECTSLOTFV     getAuxiliaryEffectSlotfv    = nullptr;
+    AL_HPP_EFX_FUNCTIONS(AL_HPP_DECLARE_CORE_FUNCTION_POINTER)
 
     //AL extension function pointers
-    //AL_EXT_STATIC_BUFFER
-    PFNALBUFFERDATASTATICPROC        bufferDataStatic            = nullptr;
-    //AL_SOFT_buffer_sub_data
-    PFNALBUFFERSUBDATASOFTPROC       bufferSubDataSOFT           = nullptr;
-    //AL_EXT_FOLDBACK
-    LPALREQUESTFOLDBACKSTART         requestFoldbackStart        = nullptr;
-    LPALREQUESTFOLDBACKSTOP          requestFoldbackStop         = nullptr;
-    //AL_SOFT_buffer_samples
-    LPALBUFFERSAMPLESSOFT            bufferSamplesSOFT           = nullptr;
-    LPALBUFFERSUBSAMPLESSOFT         bufferSubSamplesSOFT        = nullptr;
-    LPALGETBUFFERSAMPLESSOFT         getBufferSamplesSOFT        = nullptr;
-    LPALISBUFFERFORMATSUPPORTEDSOFT  isBufferFormatSupportedSOFT = nullptr;
-    //AL_SOFT_source_latency
-    LPALSOURCEDSOFT                  sourcedSOFT                 = nullptr;
-    LPALSOURCE3DSOFT                 source3dSOFT                = nullptr;
-    LPALSOURCEDVSOFT                 sourcedvSOFT                = nullptr;
-    LPALGETSOURCEDSOFT               getSourcedSOFT              = nullptr;
-    LPALGETSOURCE3DSOFT              getSource3dSOFT             = nullptr;
-    LPALGETSOURCEDVSOFT              getSourcedvSOFT             = nullptr;
-    LPALSOURCEI64SOFT                sourcei64SOFT               = nullptr;
-    LPALSOURCE3I64SOFT               source3i64SOFT              = nullptr;
-    LPALSOURCEI64VSOFT               sourcei64vSOFT              = nullptr;
-    LPALGETSOURCEI64SOFT             getSourcei64SOFT            = nullptr;
-    LPALGETSOURCE3I64SOFT            getSource3i64SOFT           = nullptr;
-    LPALGETSOURCEI64VSOFT            getSourcei64vSOFT           = nullptr;
-    //AL_SOFT_deferred_updates
-    LPALDEFERUPDATESSOFT             deferUpdatesSOFT            = nullptr;
-    LPALPROCESSUPDATESSOFT           processUpdatesSOFT          = nullptr;
-    //AL_SOFT_source_resampler
-    LPALGETSTRINGISOFT               getStringiSOFT              = nullptr;
-    //AL_SOFT_events
-    LPALEVENTCONTROLSOFT             eventControlSOFT            = nullptr;
-    LPALEVENTCALLBACKSOFT            eventCallbackSOFT           = nullptr;
-    LPALGETPOINTERSOFT               getPointerSOFT              = nullptr;
-    LPALGETPOINTERVSOFT              getPointervSOFT             = nullptr;
-    //AL_SOFT_callback_buffer
-    LPALBUFFERCALLBACKSOFT           bufferCallbackSOFT          = nullptr;
-    LPALGETBUFFERPTRSOFT             getBufferPtrSOFT            = nullptr;
-    LPALGETBUFFER3PTRSOFT            getBuffer3PtrSOFT           = nullptr;
-    LPALGETBUFFERPTRVSOFT            getBufferPtrvSOFT           = nullptr;
+    AL_HPP_AL_EXTENSION_FUNCTIONS(AL_HPP_DECLARE_FUNCTION_POINTER)
 }
 
 // error handling
+// Every wrapper operation checks for errors with al::check_error/alc::check_error, which costs a getError round trip.
+// How often that actually happens is decided by the policy, set with e.g. -DAL_HPP_ERROR_CHECK_POLICY=sampled:
+//  always   - check after every operation (default)
+//  none     - never check
+//  debug    - like always, unless NDEBUG is defined, then like none
+//  sampled  - only every AL_HPP_ERROR_CHECK_SAMPLE_RATE-th check per thread actually queries the error
+//  deferred - don't check at all, errors are collected by the implementation until report_errors() is called, e.g. once per frame
+// Since AL only keeps the first error until it's fetched, the sampled and deferred policies report the first error since the last
+// actual check, with the message of the check that found it.
+// The policy can also be chosen per call with check_error<al::check_policy::...>().
+#if !defined( AL_HPP_ERROR_CHECK_POLICY )
+#  define AL_HPP_ERROR_CHECK_POLICY always
+#endif
+#if !defined( AL_HPP_ERROR_CHECK_SAMPLE_RATE )
+#  define AL_HPP_ERROR_CHECK_SAMPLE_RATE 64
+#endif
+
+namespace al {
+    enum class check_policy {
+        always,
+        none,
+        debug,
+        sampled,
+        deferred
+    };
+
+    AL_HPP_CONST_OR_CONSTEXPR check_policy default_check_policy = check_policy::AL_HPP_ERROR_CHECK_POLICY;
+
+    namespace util {
+        template<check_policy Policy>
+        AL_HPP_INLINE bool should_check() AL_HPP_NOEXCEPT {
+            switch(Policy) {
+                case check_policy::always: return true;
+                case check_policy::none: return false;
+                case check_policy::deferred: return false;
+#if defined( NDEBUG )
+                case check_policy::debug: return false;
+#else
+                case check_policy::debug: return true;
+#endif
+                case check_policy::sampled: {
+                    static thread_local unsigned int calls = 0;
+                    return ++calls % AL_HPP_ERROR_CHECK_SAMPLE_RATE == 0;
+                }
+            }
+            return true;
+        }
+
+        // the error check behind alc::check_error(), al::check_error() and the checks of al::dispatch, which only differ in
+        // the getError they ask. Errc is alc::errc or al::errc, both have no_error as 0; error_message is found through Errc
+        template<check_policy Policy, typename Errc, typename GetError, typename... Args>
+        Errc check_error(const char* prefix, const char* message, GetError get_error, Args... args) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(!should_check<Policy>()) return Errc();
+            Errc code = static_cast<Errc>(get_error(args...));
+            // the message is only assembled when there actually is an error
+            if(code != Errc()) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS(prefix + error_message(code) + message);
+            }
+            return code;
+        }
+    }
+}
+
 namespace alc {
     enum errc {
         no_error = ALC_NO_ERROR,
@@ -462,11 +640,18 @@ namespace alc {
     }
 
     // not nodiscard, because it can be used to just throw the exception if exceptions are on
-    alc::errc check_error(ALCdevice* deviceptr = nullptr, std::string message = "") AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
-        alc::errc code = static_cast<alc::errc>(alc::getError(deviceptr));
-        if(code != no_error)
-            AL_HPP_THROW_WHEN_EXCEPTIONS("ALC Error: " + alc::error_message(code) + message);
-        return code;
+    template<al::check_policy Policy>
+    alc::errc check_error(ALCdevice* deviceptr = nullptr, const char* message = "") AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        return al::util::check_error<Policy, alc::errc>("ALC Error: ", message, alc::getError, deviceptr);
+    }
+
+    alc::errc check_error(ALCdevice* deviceptr = nullptr, const char* message = "") AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        return alc::check_error<al::default_check_policy>(deviceptr, message);
+    }
+
+    // checks regardless of the policy, call this once per frame with the deferred or sampled policies
+    alc::errc report_errors(ALCdevice* deviceptr = nullptr, const char* message = "") AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        return alc::check_error<al::check_policy::always>(deviceptr, message);
     }
 }
 namespace al {
@@ -491,11 +676,18 @@ namespace al {
     }
 
     // not nodiscard, because it can be used to just throw the exception if exceptions are on
-    al::errc check_error(std::string message = "") AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
-        al::errc code = static_cast<al::errc>(al::getError());
-        if(code != no_error)
-            AL_HPP_THROW_WHEN_EXCEPTIONS("AL Error: " + al::error_message(code) + message);
-        return code;
+    template<al::check_policy Policy>
+    al::errc check_error(const char* message = "") AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        return al::util::check_error<Policy, al::errc>("AL Error: ", message, al::getError);
+    }
+
+    al::errc check_error(const char* message = "") AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        return al::check_error<al::default_check_policy>(message);
+    }
+
+    // checks regardless of the policy, call this once per frame with the deferred or sampled policies
+    al::errc report_errors(const char* message = "") AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        return al::check_error<al::check_policy::always>(message);
     }
 }
 
@@ -511,18 +703,350 @@ namespace al {
         exponent_clamped = AL_EXPONENT_DISTANCE_CLAMPED
     };
 
+    // the formats past the first four need the extension listed for them in util::format_table
     enum format {
         mono8 = AL_FORMAT_MONO8,
         mono16 = AL_FORMAT_MONO16,
         stereo8 = AL_FORMAT_STEREO8,
-        stereo16 = AL_FORMAT_STEREO16
+        stereo16 = AL_FORMAT_STEREO16,
+        mono_float32 = AL_FORMAT_MONO_FLOAT32,
+        stereo_float32 = AL_FORMAT_STEREO_FLOAT32,
+        quad8 = AL_FORMAT_QUAD8,
+        quad16 = AL_FORMAT_QUAD16,
+        quad_float32 = AL_FORMAT_QUAD32,
+        rear8 = AL_FORMAT_REAR8,
+        rear16 = AL_FORMAT_REAR16,
+        rear_float32 = AL_FORMAT_REAR32,
+        surround51_8 = AL_FORMAT_51CHN8,
+        surround51_16 = AL_FORMAT_51CHN16,
+        surround51_float32 = AL_FORMAT_51CHN32,
+        surround61_8 = AL_FORMAT_61CHN8,
+        surround61_16 = AL_FORMAT_61CHN16,
+        surround61_float32 = AL_FORMAT_61CHN32,
+        surround71_8 = AL_FORMAT_71CHN8,
+        surround71_16 = AL_FORMAT_71CHN16,
+        surround71_float32 = AL_FORMAT_71CHN32,
+        mono_mulaw = AL_FORMAT_MONO_MULAW_EXT,
+        stereo_mulaw = AL_FORMAT_STEREO_MULAW_EXT,
+        mono_ima4 = AL_FORMAT_MONO_IMA4,
+        stereo_ima4 = AL_FORMAT_STEREO_IMA4,
+        mono_msadpcm = AL_FORMAT_MONO_MSADPCM_SOFT,
+        stereo_msadpcm = AL_FORMAT_STEREO_MSADPCM_SOFT,
+        bformat2d_8 = AL_FORMAT_BFORMAT2D_8,
+        bformat2d_16 = AL_FORMAT_BFORMAT2D_16,
+        bformat2d_float32 = AL_FORMAT_BFORMAT2D_FLOAT32,
+        bformat3d_8 = AL_FORMAT_BFORMAT3D_8,
+        bformat3d_16 = AL_FORMAT_BFORMAT3D_16,
+        bformat3d_float32 = AL_FORMAT_BFORMAT3D_FLOAT32
+    };
+
+    // how the samples of a format are stored; ima4 and msadpcm come in blocks, so they have no fixed sample size
+    enum class sample_encoding {
+        uint8,
+        int16,
+        float32,
+        mulaw,
+        ima4,
+        msadpcm
+    };
+
+    struct format_info {
+        al::format format;
+        std::size_t channels;
+        al::sample_encoding encoding;
+        bool ambisonic;
+        // the extension that adds the format, nullptr for the core ones
+        const char* extension;
+    };
+
+    namespace util {
+        AL_HPP_CONST_OR_CONSTEXPR al::format_info format_table[] = {
+            { al::format::mono8,              1, al::sample_encoding::uint8,   false, nullptr },
+            { al::format::mono16,             1, al::sample_encoding::int16,   false, nullptr },
+            { al::format::stereo8,            2, al::sample_encoding::uint8,   false, nullptr },
+            { al::format::stereo16,           2, al::sample_encoding::int16,   false, nullptr },
+            { al::format::mono_float32,       1, al::sample_encoding::float32, false, "AL_EXT_FLOAT32" },
+            { al::format::stereo_float32,     2, al::sample_encoding::float32, false, "AL_EXT_FLOAT32" },
+            { al::format::quad8,              4, al::sample_encoding::uint8,   false, "AL_EXT_MCFORMATS" },
+            { al::format::quad16,             4, al::sample_encoding::int16,   false, "AL_EXT_MCFORMATS" },
+            { al::format::quad_float32,       4, al::sample_encoding::float32, false, "AL_EXT_MCFORMATS" },
+            { al::format::rear8,              2, al::sample_encoding::uint8,   false, "AL_EXT_MCFORMATS" },
+            { al::format::rear16,             2, al::sample_encoding::int16,   false, "AL_EXT_MCFORMATS" },
+            { al::format::rear_float32,       2, al::sample_encoding::float32, false, "AL_EXT_MCFORMATS" },
+            { al::format::surround51_8,       6, al::sample_encoding::uint8,   false, "AL_EXT_MCFORMATS" },
+            { al::format::surround51_16,      6, al::sample_encoding::int16,   false, "AL_EXT_MCFORMATS" },
+            { al::format::surround51_float32, 6, al::sample_encoding::float32, false, "AL_EXT_MCFORMATS" },
+            { al::format::surround61_8,       7, al::sample_encoding::uint8,   false, "AL_EXT_MCFORMATS" },
+            { al::format::surround61_16,      7, al::sample_encoding::int16,   false, "AL_EXT_MCFORMATS" },
+            { al::format::surround61_float32, 7, al::sample_encoding::float32, false, "AL_EXT_MCFORMATS" },
+            { al::format::surround71_8,       8, al::sample_encoding::uint8,   false, "AL_EXT_MCFORMATS" },
+            { al::format::surround71_16,      8, al::sample_encoding::int16,   false, "AL_EXT_MCFORMATS" },
+            { al::format::surround71_float32, 8, al::sample_encoding::float32, false, "AL_EXT_MCFORMATS" },
+            { al::format::mono_mulaw,         1, al::sample_encoding::mulaw,   false, "AL_EXT_MULAW" },
+            { al::format::stereo_mulaw,       2, al::sample_encoding::mulaw,   false, "AL_EXT_MULAW" },
+            { al::format::mono_ima4,          1, al::sample_encoding::ima4,    false, "AL_EXT_IMA4" },
+            { al::format::stereo_ima4,        2, al::sample_encoding::ima4,    false, "AL_EXT_IMA4" },
+            { al::format::mono_msadpcm,       1, al::sample_encoding::msadpcm, false, "AL_SOFT_MSADPCM" },
+            { al::format::stereo_msadpcm,     2, al::sample_encoding::msadpcm, false, "AL_SOFT_MSADPCM" },
+            { al::format::bformat2d_8,        3, al::sample_encoding::uint8,   true,  "AL_EXT_BFORMAT" },
+            { al::format::bformat2d_16,       3, al::sample_encoding::int16,   true,  "AL_EXT_BFORMAT" },
+            { al::format::bformat2d_float32,  3, al::sample_encoding::float32, true,  "AL_EXT_BFORMAT" },
+            { al::format::bformat3d_8,        4, al::sample_encoding::uint8,   true,  "AL_EXT_BFORMAT" },
+            { al::format::bformat3d_16,       4, al::sample_encoding::int16,   true,  "AL_EXT_BFORMAT" },
+            { al::format::bformat3d_float32,  4, al::sample_encoding::float32, true,  "AL_EXT_BFORMAT" }
+        };
+
+        // single return so it stays constexpr in c++11
+        AL_HPP_NODISCARD AL_HPP_CONSTEXPR al::format_info find_format(al::format sample_format, std::size_t index) AL_HPP_NOEXCEPT {
+            return index == sizeof(format_table) / sizeof(format_table[0])
+                 ? al::format_info { sample_format, 0, al::sample_encoding::uint8, false, nullptr }
+                 : format_table[index].format == sample_format ? format_table[index] : find_format(sample_format, index + 1);
+        }
+    }
+
+    // unknown formats come back with 0 channels
+    AL_HPP_NODISCARD AL_HPP_CONSTEXPR al::format_info describe(al::format sample_format) AL_HPP_NOEXCEPT {
+        return al::util::find_format(sample_format, 0);
+    }
+
+    // 0 for the block compressed encodings
+    AL_HPP_NODISCARD AL_HPP_CONSTEXPR std::size_t sample_bytes(al::sample_encoding encoding) AL_HPP_NOEXCEPT {
+        return encoding == al::sample_encoding::int16 ? 2
+             : encoding == al::sample_encoding::float32 ? 4
+             : encoding == al::sample_encoding::uint8 || encoding == al::sample_encoding::mulaw ? 1 : 0;
+    }
+    AL_HPP_NODISCARD AL_HPP_CONSTEXPR std::size_t frame_bytes(al::format sample_format) AL_HPP_NOEXCEPT {
+        return al::describe(sample_format).channels * al::sample_bytes(al::describe(sample_format).encoding);
+    }
+    AL_HPP_NODISCARD AL_HPP_CONSTEXPR bool is_compressed(al::format sample_format) AL_HPP_NOEXCEPT {
+        return al::describe(sample_format).encoding == al::sample_encoding::ima4 || al::describe(sample_format).encoding == al::sample_encoding::msadpcm;
+    }
+
+    // channel layouts for picking a format at compile time, see al::format_of
+    template<std::size_t Count>
+    struct channels {};
+    struct bformat2d {};
+    struct bformat3d {};
+
+    // a mu-law encoded sample, so mu-law data can be told apart from uint8 by type
+    enum class mulaw_sample : std::uint8_t {};
+
+    // al::format_of<std::int16_t, al::channels<2>>::value is al::format::stereo16; combinations without a format don't compile
+    template<typename Sample, typename Layout>
+    struct format_of {
+        static_assert(sizeof(Sample) == 0, "there is no AL format for this sample type and channel layout");
+    };
+
+#define AL_HPP_FORMAT_OF(sample, layout, sample_format) \
+    template<> struct format_of<sample, layout> { static AL_HPP_CONST_OR_CONSTEXPR al::format value = sample_format; };
+#define AL_HPP_FORMATS_OF(sample, suffix) \
+    AL_HPP_FORMAT_OF(sample, al::channels<4>, al::format::quad##suffix) \
+    AL_HPP_FORMAT_OF(sample, al::channels<6>, al::format::surround51_##suffix) \
+    AL_HPP_FORMAT_OF(sample, al::channels<7>, al::format::surround61_##suffix) \
+    AL_HPP_FORMAT_OF(sample, al::channels<8>, al::format::surround71_##suffix) \
+    AL_HPP_FORMAT_OF(sample, al::bformat2d, al::format::bformat2d_##suffix) \
+    AL_HPP_FORMAT_OF(sample, al::bformat3d, al::format::bformat3d_##suffix)
+
+    AL_HPP_FORMAT_OF(std::uint8_t, al::channels<1>, al::format::mono8)
+    AL_HPP_FORMAT_OF(std::uint8_t, al::channels<2>, al::format::stereo8)
+    AL_HPP_FORMAT_OF(std::int16_t, al::channels<1>, al::format::mono16)
+    AL_HPP_FORMAT_OF(std::int16_t, al::channels<2>, al::format::stereo16)
+    AL_HPP_FORMAT_OF(float, al::channels<1>, al::format::mono_float32)
+    AL_HPP_FORMAT_OF(float, al::channels<2>, al::format::stereo_float32)
+    AL_HPP_FORMAT_OF(float, al::channels<4>, al::format::quad_float32)
+    AL_HPP_FORMAT_OF(float, al::channels<6>, al::format::surround51_float32)
+    AL_HPP_FORMAT_OF(float, al::channels<7>, al::format::surround61_float32)
+    AL_HPP_FORMAT_OF(float, al::channels<8>, al::format::surround71_float32)
+    AL_HPP_FORMAT_OF(float, al::bformat2d, al::format::bformat2d_float32)
+    AL_HPP_FORMAT_OF(float, al::bformat3d, al::format::bformat3d_float32)
+    AL_HPP_FORMAT_OF(al::mulaw_sample, al::channels<1>, al::format::mono_mulaw)
+    AL_HPP_FORMAT_OF(al::mulaw_sample, al::channels<2>, al::format::stereo_mulaw)
+    AL_HPP_FORMATS_OF(std::uint8_t, 8)
+    AL_HPP_FORMATS_OF(std::int16_t, 16)
+#undef AL_HPP_FORMATS_OF
+#undef AL_HPP_FORMAT_OF
+
+    // IMA4 or MSADPCM blocks ready for upload, see al::convert::compress. block_align is in sample frames per block.
+    struct compressed_samples {
+        al::format format = al::format::mono_ima4;
+        ALsizei frequency = 0;
+        ALsizei block_align = 0;
+        std::vector<std::uint8_t> blocks;
     };
 
     struct vec3 {
         float x, y, z;
     };
+
+    AL_HPP_NODISCARD AL_HPP_CONSTEXPR bool operator==(const vec3& a, const vec3& b) AL_HPP_NOEXCEPT { return a.x == b.x && a.y == b.y && a.z == b.z; }
+    AL_HPP_NODISCARD AL_HPP_CONSTEXPR bool operator!=(const vec3& a, const vec3& b) AL_HPP_NOEXCEPT { return !(a == b); }
 }
 
+// Sources and listeners keep a shadow copy of everything they set, so setting an unchanged value costs nothing and reading it back
+// doesn't go to the implementation. With AL_HPP_VERIFY_SHADOW_STATE defined (and NDEBUG not), every cached read is also compared
+// against the implementation with AL_HPP_ASSERT, which catches state changed behind the wrapper's back.
+#if defined( AL_HPP_VERIFY_SHADOW_STATE ) && !defined( NDEBUG )
+#  define AL_HPP_SHADOW_STATE_CHECKS
+#endif
+
+
+// opt-in instrumentation layer: with AL_HPP_INSTRUMENT defined, load() and update() replace every loaded function pointer
+// with a shim that counts the calls and measures their latency. AL/ALC errors are sticky until getError fetches them, so an
+// error is counted against the last instrumented call on the thread before that getError, which need not be the one that raised it
+#if defined( AL_HPP_INSTRUMENT )
+namespace al {
+    namespace instrument {
+        struct entry_stats {
+            const char* name;
+            std::uint64_t calls;
+            std::uint64_t total_ns;
+            std::uint64_t max_ns;
+            std::uint64_t errors;
+        };
+    }
+
+    namespace util {
+        struct instrument_counters {
+            const char* name = nullptr;
+            std::atomic<std::uint64_t> calls { 0 }, total_ns { 0 }, max_ns { 0 }, errors { 0 };
+            bool registered = false;
+        };
+
+        AL_HPP_INLINE_VARIABLE std::mutex instrument_registry_mutex;
+        AL_HPP_INLINE_VARIABLE std::vector<instrument_counters*> instrument_registry;
+
+        // the last instrumented call on this thread, so an error fetched with getError can be blamed on it
+        AL_HPP_NODISCARD inline instrument_counters*& instrument_last_call() AL_HPP_NOEXCEPT {
+            static thread_local instrument_counters* last_call = nullptr;
+            return last_call;
+        }
+
+        // records a call when it goes out of scope, so the shims also work for functions returning void
+        class instrument_timer {
+        public:
+            explicit instrument_timer(instrument_counters& counters) AL_HPP_NOEXCEPT
+                : counters_(counters), start_(std::chrono::steady_clock::now()) {}
+            ~instrument_timer() AL_HPP_NOEXCEPT {
+                std::uint64_t ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+                counters_.calls.fetch_add(1, std::memory_order_relaxed);
+                counters_.total_ns.fetch_add(ns, std::memory_order_relaxed);
+                std::uint64_t max = counters_.max_ns.load(std::memory_order_relaxed);
+                while(ns > max && !counters_.max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed));
+            }
+        private:
+            instrument_counters& counters_;
+            std::chrono::steady_clock::time_point start_;
+        };
+
+        // calls the original function; the error queries count their result against the previous call on the thread
+        template<typename R>
+        struct instrument_invoke {
+            template<typename F, typename... Args>
+            static R call(F original, instrument_counters& counters, bool error_query, Args... args) {
+                if(!error_query) {
+                    instrument_last_call() = &counters;
+                    instrument_timer timer(counters);
+                    return original(args...);
+                }
+                instrument_timer timer(counters);
+                R code = original(args...);
+                instrument_counters* last_call = instrument_last_call();
+                if(code != 0 && last_call != nullptr)
+                    last_call->errors.fetch_add(1, std::memory_order_relaxed);
+                return code;
+            }
+        };
+        template<>
+        struct instrument_invoke<void> {
+            template<typename F, typename... Args>
+            static void call(F original, instrument_counters& counters, bool, Args... args) {
+                instrument_last_call() = &counters;
+                instrument_timer timer(counters);
+                original(args...);
+            }
+        };
+
+        // one shim per function pointer variable, the variable's address is the template parameter
+        template<typename T, T* Slot>
+        struct instrument_shim;
+
+        template<typename R, typename... Args, R (AL_APIENTRY **Slot)(Args...)>
+        struct instrument_shim<R (AL_APIENTRY *)(Args...), Slot> {
+            static R (AL_APIENTRY *original)(Args...);
+            static instrument_counters counters;
+            // set for alGetError and alcGetError
+            static bool error_query;
+
+            static R AL_APIENTRY call(Args... args) {
+                return instrument_invoke<R>::call(original, counters, error_query, args...);
+            }
+        };
+        template<typename R, typename... Args, R (AL_APIENTRY **Slot)(Args...)>
+        R (AL_APIENTRY *instrument_shim<R (AL_APIENTRY *)(Args...), Slot>::original)(Args...) = nullptr;
+        template<typename R, typename... Args, R (AL_APIENTRY **Slot)(Args...)>
+        instrument_counters instrument_shim<R (AL_APIENTRY *)(Args...), Slot>::counters;
+        template<typename R, typename... Args, R (AL_APIENTRY **Slot)(Args...)>
+        bool instrument_shim<R (AL_APIENTRY *)(Args...), Slot>::error_query = false;
+
+        template<typename T, T* Slot>
+        void instrument_wrap(const char* name) AL_HPP_NOEXCEPT {
+            using shim = instrument_shim<T, Slot>;
+            // not loaded, or already wrapped
+            if(*Slot == nullptr || *Slot == &shim::call) return;
+
+            shim::original = *Slot;
+            *Slot = &shim::call;
+            if(!shim::counters.registered) {
+                shim::counters.name = name;
+                shim::counters.registered = true;
+                std::lock_guard<std::mutex> lock(instrument_registry_mutex);
+                instrument_registry.push_back(&shim::counters);
+            }
+        }
+    }
+
+    namespace instrument {
+#define AL_HPP_INSTRUMENT_FUNCTION_POINTER(space, type, name, symbol, extension) al::util::instrument_wrap<type, &space::name>(#symbol);
+
+        // wraps every function pointer that is loaded and not wrapped yet; called by load() and update()
+        inline void install() AL_HPP_NOEXCEPT {
+            al::util::instrument_shim<LPALGETERROR, &al::getError>::error_query = true;
+            al::util::instrument_shim<LPALCGETERROR, &alc::getError>::error_query = true;
+
+            AL_HPP_CORE_ALC_FUNCTIONS(AL_HPP_INSTRUMENT_FUNCTION_POINTER)
+            AL_HPP_ALC_EXTENSION_FUNCTIONS(AL_HPP_INSTRUMENT_FUNCTION_POINTER)
+            AL_HPP_CORE_AL_FUNCTIONS(AL_HPP_INSTRUMENT_FUNCTION_POINTER)
+            AL_HPP_EFX_FUNCTIONS(AL_HPP_INSTRUMENT_FUNCTION_POINTER)
+            AL_HPP_AL_EXTENSION_FUNCTIONS(AL_HPP_INSTRUMENT_FUNCTION_POINTER)
+        }
+
+        // counters of every entry point that was called at least once since the last reset()
+        AL_HPP_NODISCARD inline std::vector<entry_stats> snapshot() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            std::vector<entry_stats> stats;
+            std::lock_guard<std::mutex> lock(al::util::instrument_registry_mutex);
+            for(const al::util::instrument_counters* counters : al::util::instrument_registry) {
+                std::uint64_t calls = counters->calls.load(std::memory_order_relaxed);
+                if(calls == 0) continue;
+                stats.push_back(entry_stats { counters->name, calls,
+                                              counters->total_ns.load(std::memory_order_relaxed),
+                                              counters->max_ns.load(std::memory_order_relaxed),
+                                              counters->errors.load(std::memory_order_relaxed) });
+            }
+            return stats;
+        }
+
+        inline void reset() AL_HPP_NOEXCEPT {
+            std::lock_guard<std::mutex> lock(al::util::instrument_registry_mutex);
+            for(al::util::instrument_counters* counters : al::util::instrument_registry) {
+                counters->calls.store(0, std::memory_order_relaxed);
+                counters->total_ns.store(0, std::memory_order_relaxed);
+                counters->max_ns.store(0, std::memory_order_relaxed);
+                counters->errors.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+#endif
 
 // function pointer loading
 namespace al {
@@ -559,7 +1083,7 @@ namespace al {
             }
 
             template<typename T>
-            AL_HPP_INLINE AL_HPP_NODISCARD T sym(const char* name) const AL_HPP_NOEXCEPT {
+            AL_HPP_NODISCARD AL_HPP_INLINE T sym(const char* name) const AL_HPP_NOEXCEPT {
                 return reinterpret_cast<T>(AL_HPP_DYNAMIC_LOADER_SYMBOL_FUNCTION(library_handle, name));
             }
 
@@ -569,220 +1093,140 @@ namespace al {
 
         //convenience function template for function loading:
         template<typename T>
-        AL_HPP_INLINE AL_HPP_NODISCARD T al_sym(const char* name) AL_HPP_NOEXCEPT {
+        AL_HPP_NODISCARD AL_HPP_INLINE T al_sym(const char* name) AL_HPP_NOEXCEPT {
             return reinterpret_cast<T>(al::getProcAddress(name));
         }
         template<typename T>
-        AL_HPP_INLINE AL_HPP_NODISCARD T alc_sym(const char* name, const ALCdevice* alc_device_ptr) AL_HPP_NOEXCEPT {
+        AL_HPP_NODISCARD AL_HPP_INLINE T alc_sym(const char* name, ALCdevice* alc_device_ptr) AL_HPP_NOEXCEPT {
             return reinterpret_cast<T>(alc::getProcAddress(alc_device_ptr, name));
         }
 
-        void load_core_alc_from_module() AL_HPP_NOEXCEPT {
-            alc::createContext               = al::library->sym<LPALCCREATECONTEXT      >("alcCreateContext");
-            alc::makeContextCurrent          = al::library->sym<LPALCMAKECONTEXTCURRENT >("alcMakeContextCurrent");
-            alc::processContext              = al::library->sym<LPALCPROCESSCONTEXT     >("alcProcessContext");
-            alc::suspendContext              = al::library->sym<LPALCSUSPENDCONTEXT     >("alcSuspendContext");
-            alc::destroyContext              = al::library->sym<LPALCDESTROYCONTEXT     >("alcDestroyContext");
-            alc::getCurrentContext           = al::library->sym<LPALCGETCURRENTCONTEXT  >("alcGetCurrentContext");
-            alc::getContextsDevice           = al::library->sym<LPALCGETCONTEXTSDEVICE  >("alcGetContextsDevice");
-            alc::openDevice                  = al::library->sym<LPALCOPENDEVICE         >("alcOpenDevice");
-            alc::closeDevice                 = al::library->sym<LPALCCLOSEDEVICE        >("alcCloseDevice");
-            alc::getError                    = al::library->sym<LPALCGETERROR           >("alcGetError");
-            alc::isExtensionPresent          = al::library->sym<LPALCISEXTENSIONPRESENT >("alcIsExtensionPresent");
-            alc::getProcAddress              = al::library->sym<LPALCGETPROCADDRESS     >("alcGetProcAddress");
-            alc::getEnumValue                = al::library->sym<LPALCGETENUMVALUE       >("alcGetEnumValue");
-            alc::getString                   = al::library->sym<LPALCGETSTRING          >("alcGetString");
-            alc::getIntegerv                 = al::library->sym<LPALCGETINTEGERV        >("alcGetIntegerv");
-            alc::captureOpenDevice           = al::library->sym<LPALCCAPTUREOPENDEVICE  >("alcCaptureOpenDevice");
-            alc::captureCloseDevice          = al::library->sym<LPALCCAPTURECLOSEDEVICE >("alcCaptureCloseDevice");
-            alc::captureStart                = al::library->sym<LPALCCAPTURESTART       >("alcCaptureStart");
-            alc::captureStop                 = al::library->sym<LPALCCAPTURESTOP        >("alcCaptureStop");
-            alc::captureSamples              = al::library->sym<LPALCCAPTURESAMPLES     >("alcCaptureSamples");
-        }
-        void load_core_al_base_from_module() AL_HPP_NOEXCEPT {
-            al::enable                       = al::library->sym<LPALENABLE              >("alEnable");
-            al::disable                      = al::library->sym<LPALDISABLE             >("alDisable");
-            al::isEnabled                    = al::library->sym<LPALISENABLED           >("alIsEnabled");
-            al::getString                    = al::library->sym<LPALGETSTRING           >("alGetString");
-            al::getBooleanv                  = al::library->sym<LPALGETBOOLEANV         >("alGetBooleanv");
-            al::getIntegerv                  = al::library->sym<LPALGETINTEGERV         >("alGetIntegerv");
-            al::getFloatv                    = al::library->sym<LPALGETFLOATV           >("alGetFloatv");
-            al::getDoublev                   = al::library->sym<LPALGETDOUBLEV          >("alGetDoublev");
-            al::getBoolean                   = al::library->sym<LPALGETBOOLEAN          >("alGetBoolean");
-            al::getInteger                   = al::library->sym<LPALGETINTEGER          >("alGetInteger");
-            al::getFloat                     = al::library->sym<LPALGETFLOAT            >("alGetFloat");
-            al::getDouble                    = al::library->sym<LPALGETDOUBLE           >("alGetDouble");
-            al::getError                     = al::library->sym<LPALGETERROR            >("alGetError");
-            al::isExtensionPresent           = al::library->sym<LPALISEXTENSIONPRESENT  >("alIsExtensionPresent");
-            al::getProcAddress               = al::library->sym<LPALGETPROCADDRESS      >("alGetProcAddress");
-            al::getEnumValue                 = al::library->sym<LPALGETENUMVALUE        >("alGetEnumValue");
-        }
-        void load_core_al_rest_from_module() AL_HPP_NOEXCEPT {
-            al::dopplerFactor                = al::library->sym<LPALDOPPLERFACTOR       >("aldopplerFactor");  
-            al::dopplerVelocity              = al::library->sym<LPALDOPPLERVELOCITY     >("aldopplerVelocity");  
-            al::speedOfSound                 = al::library->sym<LPALSPEEDOFSOUND        >("alspeedOfSound"); 
-            al::distanceModel                = al::library->sym<LPALDISTANCEMODEL       >("aldistanceModel");
-            al::listenerf                    = al::library->sym<LPALLISTENERF           >("allistenerf");
-            al::listener3f                   = al::library->sym<LPALLISTENER3F          >("allistener3f");
-            al::listenerfv                   = al::library->sym<LPALLISTENERFV          >("allistenerfv");
-            al::listeneri                    = al::library->sym<LPALLISTENERI           >("allisteneri");
-            al::listener3i                   = al::library->sym<LPALLISTENER3I          >("allistener3i");
-            al::listeneriv                   = al::library->sym<LPALLISTENERIV          >("allisteneriv");
-            al::getListenerf                 = al::library->sym<LPALGETLISTENERF        >("algetListenerf");
-            al::getListener3f                = al::library->sym<LPALGETLISTENER3F       >("algetListener3f");
-            al::getListenerfv                = al::library->sym<LPALGETLISTENERFV       >("algetListenerfv");
-            al::getListeneri                 = al::library->sym<LPALGETLISTENERI        >("algetListeneri");
-            al::getListener3i                = al::library->sym<LPALGETLISTENER3I       >("algetListener3i");
-            al::getListeneriv                = al::library->sym<LPALGETLISTENERIV       >("algetListeneriv");
-            al::genSources                   = al::library->sym<LPALGENSOURCES          >("algenSources");
-            al::deleteSources                = al::library->sym<LPALDELETESOURCES       >("aldeleteSources");
-            al::isSource                     = al::library->sym<LPALISSOURCE            >("alisSource");
-            al::sourcef                      = al::library->sym<LPALSOURCEF             >("alsourcef");
-            al::source3f                     = al::library->sym<LPALSOURCE3F            >("alsource3f");
-            al::sourcefv                     = al::library->sym<LPALSOURCEFV            >("alsourcefv");
-            al::sourcei                      = al::library->sym<LPALSOURCEI             >("alsourcei");
-            al::source3i                     = al::library->sym<LPALSOURCE3I            >("alsource3i");
-            al::sourceiv                     = al::library->sym<LPALSOURCEIV            >("alsourceiv");
-            al::getSourcef                   = al::library->sym<LPALGETSOURCEF          >("algetSourcef");
-            al::getSource3f                  = al::library->sym<LPALGETSOURCE3F         >("algetSource3f");
-            al::getSourcefv                  = al::library->sym<LPALGETSOURCEFV         >("algetSourcefv");
-            al::getSourcei                   = al::library->sym<LPALGETSOURCEI          >("algetSourcei");
-            al::getSource3i                  = al::library->sym<LPALGETSOURCE3I         >("algetSource3i");
-            al::getSourceiv                  = al::library->sym<LPALGETSOURCEIV         >("algetSourceiv");
-            al::sourcePlayv                  = al::library->sym<LPALSOURCEPLAYV         >("alsourcePlayv");
-            al::sourceStopv                  = al::library->sym<LPALSOURCESTOPV         >("alsourceStopv");
-            al::sourceRewindv                = al::library->sym<LPALSOURCEREWINDV       >("alsourceRewindv");
-            al::sourcePausev                 = al::library->sym<LPALSOURCEPAUSEV        >("alsourcePausev");
-            al::sourcePlay                   = al::library->sym<LPALSOURCEPLAY          >("alsourcePlay");
-            al::sourceStop                   = al::library->sym<LPALSOURCESTOP          >("alsourceStop");
-            al::sourceRewind                 = al::library->sym<LPALSOURCEREWIND        >("alsourceRewind");
-            al::sourcePause                  = al::library->sym<LPALSOURCEPAUSE         >("alsourcePause");
-            al::sourceQueueBuffers           = al::library->sym<LPALSOURCEQUEUEBUFFERS  >("alsourceQueueBuffers");
-            al::sourceUnqueueBuffers         = al::library->sym<LPALSOURCEUNQUEUEBUFFERS>("alsourceUnqueueBuffers");
-            al::genBuffers                   = al::library->sym<LPALGENBUFFERS          >("algenBuffers");
-            al::deleteBuffers                = al::library->sym<LPALDELETEBUFFERS       >("aldeleteBuffers");
-            al::isBuffer                     = al::library->sym<LPALISBUFFER            >("alisBuffer");
-            al::bufferData                   = al::library->sym<LPALBUFFERDATA          >("albufferData");
-            al::bufferf                      = al::library->sym<LPALBUFFERF             >("albufferf");
-            al::buffer3f                     = al::library->sym<LPALBUFFER3F            >("albuffer3f");
-            al::bufferfv                     = al::library->sym<LPALBUFFERFV            >("albufferfv");
-            al::bufferi                      = al::library->sym<LPALBUFFERI             >("albufferi");
-            al::buffer3i                     = al::library->sym<LPALBUFFER3I            >("albuffer3i");
-            al::bufferiv                     = al::library->sym<LPALBUFFERIV            >("albufferiv");
-            al::getBufferf                   = al::library->sym<LPALGETBUFFERF          >("algetBufferf");
-            al::getBuffer3f                  = al::library->sym<LPALGETBUFFER3F         >("algetBuffer3f");
-            al::getBufferfv                  = al::library->sym<LPALGETBUFFERFV         >("algetBufferfv");
-            al::getBufferi                   = al::library->sym<LPALGETBUFFERI          >("algetBufferi");
-            al::getBuffer3i                  = al::library->sym<LPALGETBUFFER3I         >("algetBuffer3i");
-            al::getBufferiv                  = al::library->sym<LPALGETBUFFERIV         >("algetBufferiv");
-        }
-
-        void load_alc_extensions_from_deviceptr(const ALCdevice* device_ptr) AL_HPP_NOEXCEPT {
-            //ALC_EXT_thread_local_context
-            alc::setThreadContext            = alc_sym<PFNALCSETTHREADCONTEXTPROC>("alcSetThreadContext", device_ptr);
-            alc::getThreadContext            = alc_sym<PFNALCGETTHREADCONTEXTPROC>("alcGetThreadContext", device_ptr);
-            //ALC_SOFT_loopback
-            alc::loopbackOpenDeviceSOFT      = alc_sym<LPALCLOOPBACKOPENDEVICESOFT>("alcLoopbackOpenDeviceSOFT", device_ptr);
-            alc::isRenderFormatSupportedSOFT = alc_sym<LPALCISRENDERFORMATSUPPORTEDSOFT>("alcIsRenderFormatSupportedSOFT", device_ptr);
-            alc::renderSamplesSOFT           = alc_sym<LPALCRENDERSAMPLESSOFT>("alcRenderSamplesSOFT", device_ptr);
-            //ALC_SOFT_pause_device
-            alc::devicePauseSOFT             = alc_sym<LPALCDEVICEPAUSESOFT>("alcDevicePauseSOFT", device_ptr);
-            alc::deviceResumeSOFT            = alc_sym<LPALCDEVICERESUMESOFT>("alcDeviceResumeSOFT", device_ptr);
-            //ALC_SOFT_HRTF
-            alc::getStringiSOFT              = alc_sym<LPALCGETSTRINGISOFT>("alcGetStringiSOFT", device_ptr);
-            alc::resetDeviceSOFT             = alc_sym<LPALCRESETDEVICESOFT>("alcResetDeviceSOFT", device_ptr);
-            //ALC_SOFT_device_clock
-            alc::getInteger64vSOFT           = alc_sym<LPALCGETINTEGER64VSOFT>("alcGetInteger64vSOFT", device_ptr);
-            //ALC_SOFT_reopen_device
-            alc::reopenDeviceSOFT            = alc_sym<LPALCREOPENDEVICESOFT>("alcReopenDeviceSOFT", device_ptr);
-        }
-        void load_efx_from_al() AL_HPP_NOEXCEPT {
-            al::genEffects                      = al_sym<LPALGENEFFECTS                >("alGenEffects                ");
-            al::deleteEffects                   = al_sym<LPALDELETEEFFECTS             >("alDeleteEffects             ");
-            al::isEffect                        = al_sym<LPALISEFFECT                  >("alIsEffect                  ");
-            al::effecti                         = al_sym<LPALEFFECTI                   >("alEffecti                   ");
-            al::effectiv                        = al_sym<LPALEFFECTIV                  >("alEffectiv                  ");
-            al::effectf                         = al_sym<LPALEFFECTF                   >("alEffectf                   ");
-            al::effectfv                        = al_sym<LPALEFFECTFV                  >("alEffectfv                  ");
-            al::getEffecti                      = al_sym<LPALGETEFFECTI                >("alGetEffecti                ");
-            al::getEffectiv                     = al_sym<LPALGETEFFECTIV               >("alGetEffectiv               ");
-            al::getEffectf                      = al_sym<LPALGETEFFECTF                >("alGetEffectf                ");
-            al::getEffectfv                     = al_sym<LPALGETEFFECTFV               >("alGetEffectfv               ");
-            al::genFilters                      = al_sym<LPALGENFILTERS                >("alGenFilters                ");
-            al::deleteFilters                   = al_sym<LPALDELETEFILTERS             >("alDeleteFilters             ");
-            al::isFilter                        = al_sym<LPALISFILTER                  >("alIsFilter                  ");
-            al::filteri                         = al_sym<LPALFILTERI                   >("alFilteri                   ");
-            al::filteriv                        = al_sym<LPALFILTERIV                  >("alFilteriv                  ");
-            al::filterf                         = al_sym<LPALFILTERF                   >("alFilterf                   ");
-            al::filterfv                        = al_sym<LPALFILTERFV                  >("alFilterfv                  ");
-            al::getFilteri                      = al_sym<LPALGETFILTERI                >("alGetFilteri                ");
-            al::getFilteriv                     = al_sym<LPALGETFILTERIV               >("alGetFilteriv               ");
-            al::getFilterf                      = al_sym<LPALGETFILTERF                >("alGetFilterf                ");
-            al::getFilterfv                     = al_sym<LPALGETFILTERFV               >("alGetFilterfv               ");
-            al::genAuxiliaryEffectSlots         = al_sym<LPALGENAUXILIARYEFFECTSLOTS   >("alGenAuxiliaryEffectSlots   ");
-            al::deleteAuxiliaryEffectSlots      = al_sym<LPALDELETEAUXILIARYEFFECTSLOTS>("alDeleteAuxiliaryEffectSlots");
-            al::isAuxiliaryEffectSlot           = al_sym<LPALISAUXILIARYEFFECTSLOT     >("alIsAuxiliaryEffectSlot     ");
-            al::auxiliaryEffectSloti            = al_sym<LPALAUXILIARYEFFECTSLOTI      >("alAuxiliaryEffectSloti      ");
-            al::auxiliaryEffectSlotiv           = al_sym<LPALAUXILIARYEFFECTSLOTIV     >("alAuxiliaryEffectSlotiv     ");
-            al::auxiliaryEffectSlotf            = al_sym<LPALAUXILIARYEFFECTSLOTF      >("alAuxiliaryEffectSlotf      ");
-            al::auxiliaryEffectSlotfv           = al_sym<LPALAUXILIARYEFFECTSLOTFV     >("alAuxiliaryEffectSlotfv     ");
-            al::getAuxiliaryEffectSloti         = al_sym<LPALGETAUXILIARYEFFECTSLOTI   >("alGetAuxiliaryEffectSloti   ");
-            al::getAuxiliaryEffectSlotiv        = al_sym<LPALGETAUXILIARYEFFECTSLOTIV  >("alGetAuxiliaryEffectSlotiv  ");
-            al::getAuxiliaryEffectSlotf         = al_sym<LPALGETAUXILIARYEFFECTSLOTF   >("alGetAuxiliaryEffectSlotf   ");
-            al::getAuxiliaryEffectSlotfv        = al_sym<LPALGETAUXILIARYEFFECTSLOTFV  >("alGetAuxiliaryEffectSlotfv  ");
-        }
-        void load_al_extensions_from_al() AL_HPP_NOEXCEPT {
-            //AL_EXT_STATIC_BUFFER
-            al::bufferDataStatic             = al_sym<PFNALBUFFERDATASTATICPROC>("alBufferDataStatic");
-            //AL_SOFT_buffer_sub_data
-            al::bufferSubDataSOFT            = al_sym<PFNALBUFFERSUBDATASOFTPROC>("alBufferSubDataSOFT");
-            //AL_EXT_FOLDBACK
-            al::requestFoldbackStart         = al_sym<LPALREQUESTFOLDBACKSTART>("alRequestFoldbackStart");
-            al::requestFoldbackStop          = al_sym<LPALREQUESTFOLDBACKSTOP >("alRequestFoldbackStop");
-            //AL_SOFT_buffer_samples
-            al::bufferSamplesSOFT            = al_sym<LPALBUFFERSAMPLESSOFT          >("alBufferSamplesSOFT");
-            al::bufferSubSamplesSOFT         = al_sym<LPALBUFFERSUBSAMPLESSOFT       >("alBufferSubSamplesSOFT");
-            al::getBufferSamplesSOFT         = al_sym<LPALGETBUFFERSAMPLESSOFT       >("alGetBufferSamplesSOFT");
-            al::isBufferFormatSupportedSOFT  = al_sym<LPALISBUFFERFORMATSUPPORTEDSOFT>("alIsBufferFormatSupportedSOFT");
-            //AL_SOFT_source_latency
-            al::sourcedSOFT                  = al_sym<LPALSOURCEDSOFT      >("alSourcedSOFT");
-            al::source3dSOFT                 = al_sym<LPALSOURCE3DSOFT     >("alSource3dSOFT");
-            al::sourcedvSOFT                 = al_sym<LPALSOURCEDVSOFT     >("alSourcedvSOFT");
-            al::getSourcedSOFT               = al_sym<LPALGETSOURCEDSOFT   >("alGetSourcedSOFT");
-            al::getSource3dSOFT              = al_sym<LPALGETSOURCE3DSOFT  >("alGetSource3dSOFT");
-            al::getSourcedvSOFT              = al_sym<LPALGETSOURCEDVSOFT  >("alGetSourcedvSOFT");
-            al::sourcei64SOFT                = al_sym<LPALSOURCEI64SOFT    >("alSourcei64SOFT");
-            al::source3i64SOFT               = al_sym<LPALSOURCE3I64SOFT   >("alSource3i64SOFT");
-            al::sourcei64vSOFT               = al_sym<LPALSOURCEI64VSOFT   >("alSourcei64vSOFT");
-            al::getSourcei64SOFT             = al_sym<LPALGETSOURCEI64SOFT >("alGetSourcei64SOFT");
-            al::getSource3i64SOFT            = al_sym<LPALGETSOURCE3I64SOFT>("alGetSource3i64SOFT");
-            al::getSourcei64vSOFT            = al_sym<LPALGETSOURCEI64VSOFT>("alGetSourcei64vSOFT");
-            //AL_SOFT_deferred_updates
-            al::deferUpdatesSOFT             = al_sym<LPALDEFERUPDATESSOFT  >("alDeferUpdatesSOFT");
-            al::processUpdatesSOFT           = al_sym<LPALPROCESSUPDATESSOFT>("alProcessUpdatesSOFT");
-            //AL_SOFT_source_resampler
-            al::getStringiSOFT               = al_sym<LPALGETSTRINGISOFT>("alGetStringiSOFT");
-            //AL_SOFT_events
-            al::eventControlSOFT             = al_sym<LPALEVENTCONTROLSOFT >("alEventControlSOFT");
-            al::eventCallbackSOFT            = al_sym<LPALEVENTCALLBACKSOFT>("alEventCallbackSOFT");
-            al::getPointerSOFT               = al_sym<LPALGETPOINTERSOFT   >("alGetPointerSOFT");
-            al::getPointervSOFT              = al_sym<LPALGETPOINTERVSOFT  >("alGetPointervSOFT");
-            //AL_SOFT_callback_buffer
-            al::bufferCallbackSOFT           = al_sym<LPALBUFFERCALLBACKSOFT>("albufferCallbackSOFT");
-            al::getBufferPtrSOFT             = al_sym<LPALGETBUFFERPTRSOFT  >("algetBufferPtrSOFT");
-            al::getBuffer3PtrSOFT            = al_sym<LPALGETBUFFER3PTRSOFT >("algetBuffer3PtrSOFT");
-            al::getBufferPtrvSOFT            = al_sym<LPALGETBUFFERPTRVSOFT >("algetBufferPtrvSOFT");
-        }
+        // where a symbol gets resolved from; linked symbols are bound at compile time with AL_HPP_STATIC_DISPATCH
+        enum class symbol_source {
+            linked,
+            module,
+            alc_proc_address,
+            al_proc_address
+        };
+
+        // one row of the loader table; assign stores a resolved address into the function pointer it belongs to
+        struct symbol_entry {
+            const char* name;
+            const char* extension;
+            symbol_source source;
+            void (*assign)(void* address);
+        };
 
+        template<typename T, T* Slot>
+        void assign_symbol(void* address) AL_HPP_NOEXCEPT {
+            *Slot = reinterpret_cast<T>(address);
+        }
     }
 
+    // what load() and update() found, by symbol and extension name
+    struct load_report {
+        std::vector<const char*> found;
+        std::vector<const char*> missing;
+        std::vector<const char*> extensions_present;
+        std::vector<const char*> extensions_missing;
+
+        // true if every symbol that was looked up was found
+        AL_HPP_NODISCARD bool complete() const AL_HPP_NOEXCEPT { return missing.empty(); }
+    };
+
     // this is a singleton with the same name as the class...
-    std::unique_ptr<al::util::library> library = nullptr;
-    bool loaded = false;
+    AL_HPP_INLINE_VARIABLE std::unique_ptr<al::util::library> library = nullptr;
+    AL_HPP_INLINE_VARIABLE bool loaded = false;
+
+    namespace util {
+#define AL_HPP_ALC_PROC_SYMBOL(space, type, name, symbol, extension) { #symbol, extension, al::util::symbol_source::alc_proc_address, &al::util::assign_symbol<type, &space::name> },
+#define AL_HPP_AL_PROC_SYMBOL(space, type, name, symbol, extension) { #symbol, extension, al::util::symbol_source::al_proc_address, &al::util::assign_symbol<type, &space::name> },
+#if defined( AL_HPP_STATIC_DISPATCH )
+#  define AL_HPP_MODULE_SYMBOL(space, type, name, symbol, extension) { #symbol, extension, al::util::symbol_source::linked, nullptr },
+#else
+#  define AL_HPP_MODULE_SYMBOL(space, type, name, symbol, extension) { #symbol, extension, al::util::symbol_source::module, &al::util::assign_symbol<type, &space::name> },
+#endif
+
+        // core functions come straight from the library, all at once in load()
+        AL_HPP_CONST_OR_CONSTEXPR symbol_entry core_symbols[] = {
+            AL_HPP_CORE_ALC_FUNCTIONS(AL_HPP_MODULE_SYMBOL)
+            AL_HPP_CORE_AL_FUNCTIONS(AL_HPP_MODULE_SYMBOL)
+#if defined( AL_HPP_STATIC_DISPATCH )
+            AL_HPP_EFX_FUNCTIONS(AL_HPP_MODULE_SYMBOL)
+#endif
+        };
+
+        // extension functions come from the implementation, once their extension is known to be present;
+        // the rows of one extension are next to each other
+        AL_HPP_CONST_OR_CONSTEXPR symbol_entry extension_symbols[] = {
+            AL_HPP_ALC_EXTENSION_FUNCTIONS(AL_HPP_ALC_PROC_SYMBOL)
+#if !defined( AL_HPP_STATIC_DISPATCH )
+            AL_HPP_EFX_FUNCTIONS(AL_HPP_AL_PROC_SYMBOL)
+#endif
+            AL_HPP_AL_EXTENSION_FUNCTIONS(AL_HPP_AL_PROC_SYMBOL)
+        };
+
+        inline void* resolve_symbol(const symbol_entry& entry, ALCdevice* device_ptr) AL_HPP_NOEXCEPT {
+            switch(entry.source) {
+                case symbol_source::linked: return nullptr;
+                case symbol_source::module: return al::library->sym<void*>(entry.name);
+                case symbol_source::alc_proc_address: return alc::getProcAddress(device_ptr, entry.name);
+                case symbol_source::al_proc_address: return al::getProcAddress(entry.name);
+            }
+            return nullptr;
+        }
+
+        inline void load_symbol(const symbol_entry& entry, ALCdevice* device_ptr, load_report& report) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(entry.source == symbol_source::linked) {
+                report.found.push_back(entry.name);
+                return;
+            }
+            void* address = resolve_symbol(entry, device_ptr);
+            entry.assign(address);
+            (address != nullptr ? report.found : report.missing).push_back(entry.name);
+        }
 
-    void load(AL_HPP_PATH library_path = "") AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
-        if(al::loaded) return;
+        // ALC extensions are per device, AL extensions are checked against the current context
+        inline bool extension_present(const char* extension, ALCdevice* device_ptr) AL_HPP_NOEXCEPT {
+            if(std::strncmp(extension, "ALC_", 4) == 0)
+                return alc::isExtensionPresent(device_ptr, extension) == ALC_TRUE;
+            return alc::getCurrentContext() != nullptr && al::isExtensionPresent(extension) == AL_TRUE;
+        }
+
+        // the report of the last load(), handed out again if load() is called while already loaded
+        AL_HPP_INLINE_VARIABLE load_report core_report;
+    }
+
+    // resolves the functions of a single extension, if it's present. Returns whether it is.
+    inline bool load_extension(const char* extension, ALCdevice* device_ptr = nullptr, load_report* report = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        load_report local_report;
+        if(report == nullptr) report = &local_report;
+
+        // without a current context there's no telling whether an AL extension is there, so keep whatever was loaded before
+        if(std::strncmp(extension, "ALC_", 4) != 0 && alc::getCurrentContext() == nullptr) {
+            report->extensions_missing.push_back(extension);
+            return false;
+        }
+
+        bool present = al::util::extension_present(extension, device_ptr);
+        (present ? report->extensions_present : report->extensions_missing).push_back(extension);
+        for(const al::util::symbol_entry& entry : al::util::extension_symbols) {
+            if(std::strcmp(entry.extension, extension) != 0) continue;
+            if(present)
+                al::util::load_symbol(entry, device_ptr, *report);
+            else
+                entry.assign(nullptr);
+        }
+#if defined( AL_HPP_INSTRUMENT )
+        if(present) al::instrument::install();
+#endif
+        return present;
+    }
 
+    inline load_report load(AL_HPP_PATH library_path = "") AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        if(al::loaded) return al::util::core_report;
+
+#if !defined( AL_HPP_STATIC_DISPATCH )
         // only load library once
         if(library == nullptr) {
             std::vector<AL_HPP_PATH> paths;
@@ -792,37 +1236,161 @@ namespace al {
             library = std::make_unique<al::util::library>(paths);
             
             // for AL_HPP_NO_EXCEPTIONS
-            if(library == nullptr) return;
+            if(library == nullptr) return load_report();
         }
+#else
+        // the core functions are linked in, there is no library to open
+        (void)library_path;
+#endif
 
-        al::util::load_core_alc_from_module();
-        al::util::load_core_al_base_from_module();
-        al::util::load_core_al_rest_from_module();
+        load_report report;
+        report.found.reserve(sizeof(al::util::core_symbols) / sizeof(al::util::core_symbols[0]));
+        for(const al::util::symbol_entry& entry : al::util::core_symbols)
+            al::util::load_symbol(entry, nullptr, report);
 
+#if defined( AL_HPP_INSTRUMENT )
+        al::instrument::install();
+#endif
         al::loaded = true;
+        al::util::core_report = report;
+        return report;
     }
 
-    void update(const ALCdevice* device_ptr) AL_HPP_NOEXCEPT {
-        al::util::load_alc_extensions_from_deviceptr(device_ptr);
-        al::util::load_efx_from_al();
-        al::util::load_al_extensions_from_al();
+    // loads the extension functions for the device; AL extensions can only be seen with a current context on that device
+    inline load_report update(ALCdevice* device_ptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        load_report report;
+        const char* extension = nullptr;
+        for(const al::util::symbol_entry& entry : al::util::extension_symbols) {
+            if(extension != nullptr && std::strcmp(entry.extension, extension) == 0) continue;
+            extension = entry.extension;
+            load_extension(extension, device_ptr, &report);
+        }
+        return report;
     }
 
-    void update() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+    inline load_report update() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
         ALCcontext* current_context = alc::getCurrentContext();
         alc::check_error();
         ALCdevice* current_contexts_device_ptr = alc::getContextsDevice(current_context);
         // does this do the same error check, or is the default error check different from resetting device errors?
         alc::check_error();
         alc::check_error(current_contexts_device_ptr);
-        update(current_contexts_device_ptr);
+        return update(current_contexts_device_ptr);
     }
 
-    void unload() AL_HPP_NOEXCEPT {
+    inline void unload() AL_HPP_NOEXCEPT {
+        // don't leave pointers into the closed library behind
+        for(const al::util::symbol_entry& entry : al::util::core_symbols)
+            if(entry.assign != nullptr) entry.assign(nullptr);
+        for(const al::util::symbol_entry& entry : al::util::extension_symbols)
+            entry.assign(nullptr);
+        al::loaded = false;
         library.reset();
     }
 }
 
+// instance-scoped dispatch
+namespace al {
+    // A complete OpenAL implementation of its own: owns a library handle and a function table, so several implementations
+    // (say a hardware driver for playback and OpenAL Soft for loopback rendering) can be used side by side in one process.
+    // The global function pointers of al::load() aren't touched. Members are named after the exported symbols, like in
+    // vulkan.hpp's dynamic dispatch loader. Devices created with a dispatch call through it, and so do listeners and
+    // sources created from them. Not copyable or movable, since bound objects point to it.
+    class dispatch {
+    public:
+#define AL_HPP_DISPATCH_MEMBER(space, type, name, symbol, extension) type symbol = nullptr;
+        AL_HPP_CORE_ALC_FUNCTIONS(AL_HPP_DISPATCH_MEMBER)
+        AL_HPP_ALC_EXTENSION_FUNCTIONS(AL_HPP_DISPATCH_MEMBER)
+        AL_HPP_CORE_AL_FUNCTIONS(AL_HPP_DISPATCH_MEMBER)
+        AL_HPP_EFX_FUNCTIONS(AL_HPP_DISPATCH_MEMBER)
+        AL_HPP_AL_EXTENSION_FUNCTIONS(AL_HPP_DISPATCH_MEMBER)
+
+        // opens the library (the default ones if library_path is empty) and resolves the core functions
+        AL_HPP_NODISCARD explicit dispatch(AL_HPP_PATH library_path = "") AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            std::vector<AL_HPP_PATH> paths;
+            if(library_path != "") paths.push_back(library_path);
+            paths.push_back(AL_HPP_LIBRARY_NAME);
+            paths.push_back(AL_HPP_SECONDARY_LIBRARY_NAME);
+            library_ = std::make_unique<al::util::library>(paths);
+
+#define AL_HPP_DISPATCH_LOAD_CORE(space, type, name, symbol, extension) symbol = resolved<type>(library_->sym<void*>(#symbol), #symbol, report_);
+            AL_HPP_CORE_ALC_FUNCTIONS(AL_HPP_DISPATCH_LOAD_CORE)
+            AL_HPP_CORE_AL_FUNCTIONS(AL_HPP_DISPATCH_LOAD_CORE)
+        }
+
+        dispatch(const dispatch&) = delete;
+        dispatch& operator=(const dispatch&) = delete;
+
+        // loads the extension functions of this implementation for the device, see al::update()
+        load_report update(ALCdevice* device_ptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            load_report report;
+            const char* previous = nullptr;
+#define AL_HPP_DISPATCH_UPDATE_EXTENSION(space, type, name, symbol, extension) \
+            if(previous == nullptr || std::strcmp(previous, extension) != 0) { previous = extension; load_extension(extension, device_ptr, &report); }
+            AL_HPP_ALC_EXTENSION_FUNCTIONS(AL_HPP_DISPATCH_UPDATE_EXTENSION)
+            AL_HPP_EFX_FUNCTIONS(AL_HPP_DISPATCH_UPDATE_EXTENSION)
+            AL_HPP_AL_EXTENSION_FUNCTIONS(AL_HPP_DISPATCH_UPDATE_EXTENSION)
+            return report;
+        }
+
+        // resolves the functions of a single extension, if it's present. Returns whether it is. See al::load_extension()
+        bool load_extension(const char* wanted, ALCdevice* device_ptr = nullptr, load_report* report = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            load_report local_report;
+            if(report == nullptr) report = &local_report;
+
+            bool present = std::strncmp(wanted, "ALC_", 4) == 0
+                         ? alcIsExtensionPresent(device_ptr, wanted) == ALC_TRUE
+                         : alcGetCurrentContext() != nullptr && alIsExtensionPresent(wanted) == AL_TRUE;
+            (present ? report->extensions_present : report->extensions_missing).push_back(wanted);
+
+#define AL_HPP_DISPATCH_LOAD_ALC_EXTENSION(space, type, name, symbol, extension) \
+            if(std::strcmp(extension, wanted) == 0) symbol = present ? resolved<type>(alcGetProcAddress(device_ptr, #symbol), #symbol, *report) : nullptr;
+#define AL_HPP_DISPATCH_LOAD_AL_EXTENSION(space, type, name, symbol, extension) \
+            if(std::strcmp(extension, wanted) == 0) symbol = present ? resolved<type>(alGetProcAddress(#symbol), #symbol, *report) : nullptr;
+            AL_HPP_ALC_EXTENSION_FUNCTIONS(AL_HPP_DISPATCH_LOAD_ALC_EXTENSION)
+            AL_HPP_EFX_FUNCTIONS(AL_HPP_DISPATCH_LOAD_AL_EXTENSION)
+            AL_HPP_AL_EXTENSION_FUNCTIONS(AL_HPP_DISPATCH_LOAD_AL_EXTENSION)
+            return present;
+        }
+
+        // what the constructor found
+        AL_HPP_NODISCARD const load_report& report() const AL_HPP_NOEXCEPT { return report_; }
+
+        // like alc::check_error() and al::check_error(), but asking this implementation
+        template<al::check_policy Policy = al::default_check_policy>
+        alc::errc check_alc_error(ALCdevice* device_ptr = nullptr, const char* message = "") const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            return al::util::check_error<Policy, alc::errc>("ALC Error: ", message, alcGetError, device_ptr);
+        }
+        template<al::check_policy Policy = al::default_check_policy>
+        al::errc check_al_error(const char* message = "") const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            return al::util::check_error<Policy, al::errc>("AL Error: ", message, alGetError);
+        }
+
+    private:
+        template<typename T, typename Address>
+        static T resolved(Address address, const char* name, load_report& report) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            (address != nullptr ? report.found : report.missing).push_back(name);
+            return reinterpret_cast<T>(address);
+        }
+
+        std::unique_ptr<al::util::library> library_;
+        load_report report_;
+    };
+
+// picks the function from the dispatch an object is bound to, or the global one if it isn't bound to any
+#define AL_HPP_DISPATCHED(dispatch_ptr, space, name, symbol) ((dispatch_ptr) != nullptr ? (dispatch_ptr)->symbol : space::name)
+
+    namespace util {
+        // error checks for objects that may be bound to a dispatch
+        AL_HPP_INLINE alc::errc check_alc_error(const al::dispatch* dispatch_ptr, ALCdevice* device_ptr, const char* message = "") AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            return dispatch_ptr != nullptr ? dispatch_ptr->check_alc_error(device_ptr, message) : alc::check_error(device_ptr, message);
+        }
+        AL_HPP_INLINE al::errc check_al_error(const al::dispatch* dispatch_ptr, const char* message = "") AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            return dispatch_ptr != nullptr ? dispatch_ptr->check_al_error(message) : al::check_error(message);
+        }
+    }
+}
+
 
 // object model for OpenAL - devices, buffers, listeners and sources
 namespace al {
@@ -859,35 +1427,179 @@ namespace al {
             return string_list;
         }
 
-        // for more sane lists, like the ' '-delimited extension string list
-        // built on recommendations by u/Mason-B and u/topological_rabbit respectively in the same thread as above
-        AL_HPP_NODISCARD std::vector<std::string> split_string_copy(const std::string& str, const char delim = ' ') AL_HPP_NOEXCEPT {
-            std::stringstream input_stream { str };
-            std::vector<std::string> string_list;
-            std::string current_string;
+        // Lazily splits a delim-separated list, like the ' '-delimited extension strings, without allocating. Empty pieces
+        // (doubled or trailing delimiters) are skipped. The views point into str, which has to outlive the range.
+        class split_range {
+        public:
+            class iterator {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = nonstd::string_view;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const nonstd::string_view*;
+                using reference = const nonstd::string_view&;
+
+                iterator() = default;
+                iterator(nonstd::string_view rest, char delim) AL_HPP_NOEXCEPT : rest_{rest}, delim_{delim} { advance(); }
+
+                reference operator*() const AL_HPP_NOEXCEPT { return current_; }
+                pointer operator->() const AL_HPP_NOEXCEPT { return &current_; }
+                iterator& operator++() AL_HPP_NOEXCEPT { advance(); return *this; }
+                iterator operator++(int) AL_HPP_NOEXCEPT { iterator previous = *this; advance(); return previous; }
+
+                // every exhausted iterator is equal to end()
+                bool operator==(const iterator& other) const AL_HPP_NOEXCEPT {
+                    return done_ == other.done_ && (done_ || current_.data() == other.current_.data());
+                }
+                bool operator!=(const iterator& other) const AL_HPP_NOEXCEPT { return !(*this == other); }
+
+            private:
+                void advance() AL_HPP_NOEXCEPT {
+                    while(!rest_.empty() && rest_.front() == delim_) rest_.remove_prefix(1);
+                    if(rest_.empty()) {
+                        done_ = true;
+                        return;
+                    }
+                    const std::size_t length = std::min(rest_.find(delim_), rest_.size());
+                    current_ = rest_.substr(0, length);
+                    done_ = false;
+                    rest_.remove_prefix(length);
+                }
+
+                nonstd::string_view rest_, current_;
+                char delim_ = ' ';
+                bool done_ = true;
+            };
+
+            AL_HPP_NODISCARD split_range(nonstd::string_view str, char delim = ' ') AL_HPP_NOEXCEPT : str_{str}, delim_{delim} {}
+
+            AL_HPP_NODISCARD iterator begin() const AL_HPP_NOEXCEPT { return iterator(str_, delim_); }
+            AL_HPP_NODISCARD iterator end()   const AL_HPP_NOEXCEPT { return iterator(); }
 
-            while( std::getline( input_stream, current_string, delim ) )
-                    string_list.emplace_back( std::move( current_string ) );
+        private:
+            nonstd::string_view str_;
+            char delim_;
+        };
+
+        // null is an empty list, since that's what the AL string getters return on errors
+        AL_HPP_NODISCARD AL_HPP_INLINE split_range split(const char* str, char delim = ' ') AL_HPP_NOEXCEPT {
+            return split_range(str != nullptr ? nonstd::string_view(str) : nonstd::string_view(), delim);
+        }
 
+        AL_HPP_NODISCARD std::vector<std::string> split_string_copy(const std::string& str, const char delim = ' ') AL_HPP_NOEXCEPT {
+            std::vector<std::string> string_list;
+            for(nonstd::string_view piece : split_range(str, delim))
+                string_list.emplace_back(piece.data(), piece.size());
             return string_list;
         }
 
         AL_HPP_NODISCARD std::vector<nonstd::string_view> split_string(const std::string& str, const char delim = ' ') AL_HPP_NOEXCEPT {
-            std::vector<nonstd::string_view> string_list;
+            split_range pieces(str, delim);
+            return std::vector<nonstd::string_view>(pieces.begin(), pieces.end());
+        }
 
-            size_t begin = 0, end;
-            while((end = str.find(delim,begin)) != std::string::npos) {
-                string_list.emplace_back(&(str.c_str())[begin], end-begin);
-                begin = end;
-            }
-            if(begin != str.size())
-                string_list.emplace_back(&(str.c_str())[begin], str.size()-begin);
+    }
 
-            return string_list;
+    // Every AL and ALC extension al.hpp knows of, for device::has(). AL extensions drop the "AL_" prefix, ALC ones keep
+    // theirs as "alc_". The order matches util::extension_names.
+#define AL_HPP_EXTENSIONS(X) \
+    X(ext_alaw                 , "AL_EXT_ALAW") \
+    X(ext_bformat              , "AL_EXT_BFORMAT") \
+    X(ext_debug                , "AL_EXT_debug") \
+    X(ext_direct_context       , "AL_EXT_direct_context") \
+    X(ext_double               , "AL_EXT_DOUBLE") \
+    X(ext_exponent_distance    , "AL_EXT_EXPONENT_DISTANCE") \
+    X(ext_float32              , "AL_EXT_FLOAT32") \
+    X(ext_foldback             , "AL_EXT_FOLDBACK") \
+    X(ext_ima4                 , "AL_EXT_IMA4") \
+    X(ext_linear_distance      , "AL_EXT_LINEAR_DISTANCE") \
+    X(ext_mcformats            , "AL_EXT_MCFORMATS") \
+    X(ext_mulaw                , "AL_EXT_MULAW") \
+    X(ext_mulaw_bformat        , "AL_EXT_MULAW_BFORMAT") \
+    X(ext_mulaw_mcformats      , "AL_EXT_MULAW_MCFORMATS") \
+    X(ext_offset               , "AL_EXT_OFFSET") \
+    X(ext_source_distance_model, "AL_EXT_source_distance_model") \
+    X(ext_source_radius        , "AL_EXT_SOURCE_RADIUS") \
+    X(ext_static_buffer        , "AL_EXT_STATIC_BUFFER") \
+    X(ext_stereo_angles        , "AL_EXT_STEREO_ANGLES") \
+    X(loki_quadriphonic        , "AL_LOKI_quadriphonic") \
+    X(soft_bformat_ex          , "AL_SOFT_bformat_ex") \
+    X(soft_bformat_hoa         , "AL_SOFT_bformat_hoa") \
+    X(soft_block_alignment     , "AL_SOFT_block_alignment") \
+    X(soft_buffer_length_query , "AL_SOFT_buffer_length_query") \
+    X(soft_buffer_samples      , "AL_SOFT_buffer_samples") \
+    X(soft_buffer_sub_data     , "AL_SOFT_buffer_sub_data") \
+    X(soft_callback_buffer     , "AL_SOFT_callback_buffer") \
+    X(soft_deferred_updates    , "AL_SOFT_deferred_updates") \
+    X(soft_direct_channels     , "AL_SOFT_direct_channels") \
+    X(soft_direct_channels_remix, "AL_SOFT_direct_channels_remix") \
+    X(soft_effect_target       , "AL_SOFT_effect_target") \
+    X(soft_events              , "AL_SOFT_events") \
+    X(soft_gain_clamp_ex       , "AL_SOFT_gain_clamp_ex") \
+    X(soft_loop_points         , "AL_SOFT_loop_points") \
+    X(soft_msadpcm             , "AL_SOFT_MSADPCM") \
+    X(soft_source_latency      , "AL_SOFT_source_latency") \
+    X(soft_source_length       , "AL_SOFT_source_length") \
+    X(soft_source_resampler    , "AL_SOFT_source_resampler") \
+    X(soft_source_spatialize   , "AL_SOFT_source_spatialize") \
+    X(soft_source_start_delay  , "AL_SOFT_source_start_delay") \
+    X(soft_uhj                 , "AL_SOFT_UHJ") \
+    X(soft_uhj_ex              , "AL_SOFT_UHJ_ex") \
+    X(alc_enumerate_all_ext    , "ALC_ENUMERATE_ALL_EXT") \
+    X(alc_enumeration_ext      , "ALC_ENUMERATION_EXT") \
+    X(alc_ext_capture          , "ALC_EXT_CAPTURE") \
+    X(alc_ext_debug            , "ALC_EXT_debug") \
+    X(alc_ext_dedicated        , "ALC_EXT_DEDICATED") \
+    X(alc_ext_direct_context   , "ALC_EXT_direct_context") \
+    X(alc_ext_disconnect       , "ALC_EXT_disconnect") \
+    X(alc_ext_efx              , "ALC_EXT_EFX") \
+    X(alc_ext_thread_local_context, "ALC_EXT_thread_local_context") \
+    X(alc_soft_device_clock    , "ALC_SOFT_device_clock") \
+    X(alc_soft_hrtf            , "ALC_SOFT_HRTF") \
+    X(alc_soft_loopback        , "ALC_SOFT_loopback") \
+    X(alc_soft_loopback_bformat, "ALC_SOFT_loopback_bformat") \
+    X(alc_soft_output_limiter  , "ALC_SOFT_output_limiter") \
+    X(alc_soft_output_mode     , "ALC_SOFT_output_mode") \
+    X(alc_soft_pause_device    , "ALC_SOFT_pause_device") \
+    X(alc_soft_reopen_device   , "ALC_SOFT_reopen_device") \
+    X(alc_soft_system_events   , "ALC_SOFT_system_events")
+
+#define AL_HPP_EXTENSION_ENUMERATOR(enumerator, name) enumerator,
+#define AL_HPP_EXTENSION_NAME(enumerator, name) name,
+    enum class ext : std::uint8_t {
+        AL_HPP_EXTENSIONS(AL_HPP_EXTENSION_ENUMERATOR)
+        count
+    };
+
+    namespace util {
+        AL_HPP_CONST_OR_CONSTEXPR const char* extension_names[] = {
+            AL_HPP_EXTENSIONS(AL_HPP_EXTENSION_NAME)
+        };
+
+        // extension names are case insensitive
+        AL_HPP_NODISCARD AL_HPP_INLINE bool same_extension(nonstd::string_view a, const char* b) AL_HPP_NOEXCEPT {
+            std::size_t i = 0;
+            for(; i < a.size() && b[i] != '\0'; ++i)
+                if(std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) return false;
+            return i == a.size() && b[i] == '\0';
         }
 
+        // ext::count for unknown names
+        AL_HPP_NODISCARD AL_HPP_INLINE al::ext find_extension(nonstd::string_view name) AL_HPP_NOEXCEPT {
+            for(std::size_t i = 0; i < static_cast<std::size_t>(al::ext::count); ++i)
+                if(same_extension(name, extension_names[i])) return static_cast<al::ext>(i);
+            return al::ext::count;
+        }
+    }
+#undef AL_HPP_EXTENSION_NAME
+#undef AL_HPP_EXTENSION_ENUMERATOR
+
+    AL_HPP_NODISCARD AL_HPP_CONSTEXPR const char* extension_name(al::ext extension) AL_HPP_NOEXCEPT {
+        return extension < al::ext::count ? al::util::extension_names[static_cast<std::size_t>(extension)] : "";
     }
 
+    using extension_set = std::bitset<static_cast<std::size_t>(al::ext::count)>;
+
     AL_HPP_NODISCARD std::vector<std::string> device_names() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
         if(! alc::isExtensionPresent(nullptr, "ALC_ENUMERATION_EXT")) {
             AL_HPP_THROW_WHEN_EXCEPTIONS("Error! Can't enumerate Devices because of missing Core Extension to OpenAL (Enumeration Extension)");
@@ -904,80 +1616,111 @@ namespace al {
     class device {
     public:
         AL_HPP_NODISCARD device(const char* device_name = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
-            device_ptr_ = alc::openDevice(device_name);
-            alc::check_error(nullptr,"(opening ALC device)");
-            alc::check_error(device_ptr_,"(opening ALC device)");
-            if(device_ptr_ == nullptr) {
-                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: could not open ALC device!");
-                return;
-            }
-
-            if(device_name != nullptr)
-                name_ = std::string(device_name);
+            open(device_name);
+        }
 
-            update_info();
+        // opens the device with the implementation of device_dispatch, which has to outlive the device
+        AL_HPP_NODISCARD explicit device(const al::dispatch& device_dispatch, const char* device_name = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                        : dispatch_{&device_dispatch} {
+            open(device_name);
         }
 
+        // ALC information, available as soon as the device is open
         void update_info() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
-            alc::getIntegerv(device_ptr_, ALC_MINOR_VERSION, 1, &alc_version_.minor);
+            AL_HPP_DISPATCHED(dispatch_, alc, getIntegerv, alcGetIntegerv)(device_ptr_, ALC_MINOR_VERSION, 1, &alc_version_.minor);
+            check();
+            AL_HPP_DISPATCHED(dispatch_, alc, getIntegerv, alcGetIntegerv)(device_ptr_, ALC_MAJOR_VERSION, 1, &alc_version_.major);
             check();
-            alc::getIntegerv(device_ptr_, ALC_MAJOR_VERSION, 1, &alc_version_.major);
+
+            const ALCchar* alc_extensions = AL_HPP_DISPATCHED(dispatch_, alc, getString, alcGetString)(device_ptr_, ALC_EXTENSIONS);
             check();
 
-            vendor_ = al::getString(AL_VENDOR);
-            al::check_error();
-            al_version_ = al::getString(AL_VERSION);
-            al::check_error();
-            renderer_ = al::getString(AL_RENDERER);
-            al::check_error();
-            std::string extensions_string = al::getString(AL_EXTENSIONS);
-            al::check_error();
-            extensions_ = al::util::split_string_copy(extensions_string, ' ');
+            // parsed once here, so has() is a single bit test
+            reset_extensions(true);
+            for(nonstd::string_view extension : al::util::split(alc_extensions))
+                add_extension(extension);
+        }
+
+        // AL information, which needs a context on this device to be current; the listener constructor calls it
+        void update_context_info() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            auto get_string = [this](ALenum parameter) {
+                const ALchar* value = AL_HPP_DISPATCHED(dispatch_, al, getString, alGetString)(parameter);
+                return value != nullptr ? value : "";
+            };
+            vendor_ = get_string(AL_VENDOR);
+            al::util::check_al_error(dispatch_);
+            al_version_ = get_string(AL_VERSION);
+            al::util::check_al_error(dispatch_);
+            renderer_ = get_string(AL_RENDERER);
+            al::util::check_al_error(dispatch_);
+            const char* al_extensions = get_string(AL_EXTENSIONS);
+            al::util::check_al_error(dispatch_);
+
+            extensions_.clear();
+            reset_extensions(false);
+            for(nonstd::string_view extension : al::util::split(al_extensions)) {
+                extensions_.emplace_back(extension.data(), extension.size());
+                add_extension(extension);
+            }
+        }
+
+        AL_HPP_NODISCARD bool has(al::ext extension) const AL_HPP_NOEXCEPT {
+            return extension < al::ext::count && extension_bits_[static_cast<std::size_t>(extension)];
         }
+        // all known AL and ALC extensions the device supports
+        AL_HPP_NODISCARD const al::extension_set& extension_set() const AL_HPP_NOEXCEPT { return extension_bits_; }
 
         // don't copy handlers
         device(const device&) = delete;
         device& operator=(const device&) = delete;
 
         // instead. use move operations
-        device(device&& old_device) : device_ptr_{old_device.device_ptr_},
-                                      alc_version_(old_device.alc_version_),
-                                      name_(old_device.name_),
-                                      vendor_(old_device.vendor_),
-                                      al_version_(old_device.al_version_),
-                                      renderer_(old_device.renderer_),
-                                      extensions_(old_device.extensions_) {
+        device(device&& old_device) AL_HPP_NOEXCEPT : device_ptr_{old_device.device_ptr_},
+                                                      dispatch_{old_device.dispatch_},
+                                                      alc_version_(old_device.alc_version_),
+                                                      name_(std::move(old_device.name_)),
+                                                      vendor_(std::move(old_device.vendor_)),
+                                                      al_version_(std::move(old_device.al_version_)),
+                                                      renderer_(std::move(old_device.renderer_)),
+                                                      extensions_(std::move(old_device.extensions_)),
+                                                      extension_bits_(old_device.extension_bits_) {
             old_device.device_ptr_ = nullptr;
         }
-        device& operator=(device&& old_device) {
+        // closes the device this one had open
+        device& operator=(device&& old_device) AL_HPP_NOEXCEPT {
+            if(this == &old_device) return *this;
+            if(device_ptr_ != nullptr)
+                AL_HPP_DISPATCHED(dispatch_, alc, closeDevice, alcCloseDevice)(device_ptr_);
+
             device_ptr_ = old_device.device_ptr_;
+            dispatch_ = old_device.dispatch_;
             alc_version_ = old_device.alc_version_;
-            name_ = old_device.name_;
-            vendor_ = old_device.vendor_;
-            al_version_ = old_device.al_version_;
-            renderer_ = old_device.renderer_;
-            extensions_ = old_device.extensions_;
+            name_ = std::move(old_device.name_);
+            vendor_ = std::move(old_device.vendor_);
+            al_version_ = std::move(old_device.al_version_);
+            renderer_ = std::move(old_device.renderer_);
+            extensions_ = std::move(old_device.extensions_);
+            extension_bits_ = old_device.extension_bits_;
 
             old_device.device_ptr_ = nullptr;
             return *this;
         }
-        
-
 
-        
         ~device() AL_HPP_NOEXCEPT {
             if(device_ptr_ != nullptr)
-                alc::closeDevice(device_ptr_);
+                AL_HPP_DISPATCHED(dispatch_, alc, closeDevice, alcCloseDevice)(device_ptr_);
         }
 
 
         // only checks ALC errors
-        void check(std::string message = "") const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
-            alc::check_error(device_ptr_, message);
+        void check(const char* message = "") const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            al::util::check_alc_error(dispatch_, device_ptr_, message);
         }
 
         // returns non-owning pointer
         AL_HPP_NODISCARD ALCdevice*  device_ptr()   const AL_HPP_NOEXCEPT { return device_ptr_; }
+        // the dispatch the device was opened with, nullptr for the global function pointers
+        AL_HPP_NODISCARD const al::dispatch* dispatch_ptr() const AL_HPP_NOEXCEPT { return dispatch_; }
 
         
         // device information
@@ -989,9 +1732,45 @@ namespace al {
         AL_HPP_NODISCARD auto        extensions()   const AL_HPP_NOEXCEPT { return extensions_; }
 
 
+    protected:
+        // takes over an already opened handle, e.g. one from alcLoopbackOpenDeviceSOFT.
+        // doesn't call update_info(), the handle may be null; the derived class does that once it checked the handle
+        device(gsl::owner<ALCdevice*> device_ptr, const char* device_name, const al::dispatch* device_dispatch = nullptr) AL_HPP_NOEXCEPT
+              : device_ptr_{device_ptr}, dispatch_{device_dispatch} {
+            if(device_name != nullptr)
+                name_ = std::string(device_name);
+        }
+
     private:
+        // the ALC extensions or the AL ones, told apart by their prefix
+        void reset_extensions(bool alc) AL_HPP_NOEXCEPT {
+            for(std::size_t i = 0; i < static_cast<std::size_t>(al::ext::count); ++i)
+                if((al::util::extension_names[i][2] == 'C') == alc) extension_bits_.reset(i);
+        }
+
+        void add_extension(nonstd::string_view extension) AL_HPP_NOEXCEPT {
+            const al::ext known = al::util::find_extension(extension);
+            if(known != al::ext::count) extension_bits_.set(static_cast<std::size_t>(known));
+        }
+
+        void open(const char* device_name) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            device_ptr_ = AL_HPP_DISPATCHED(dispatch_, alc, openDevice, alcOpenDevice)(device_name);
+            al::util::check_alc_error(dispatch_, nullptr, "(opening ALC device)");
+            al::util::check_alc_error(dispatch_, device_ptr_, "(opening ALC device)");
+            if(device_ptr_ == nullptr) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: could not open ALC device!");
+                return;
+            }
+
+            if(device_name != nullptr)
+                name_ = std::string(device_name);
+
+            update_info();
+        }
+
         // owner because the device object owns a _handle_, not an allocation
         gsl::owner<ALCdevice*> device_ptr_ = nullptr;
+        const al::dispatch* dispatch_ = nullptr;
 
         struct {
             int major;
@@ -999,27 +1778,488 @@ namespace al {
         } alc_version_;
         std::string name_ = "", vendor_, al_version_, renderer_;
         std::vector<std::string> extensions_;
+        al::extension_set extension_bits_;
 
     };
 
 
+    // Scoped batch of property changes: everything set on sources and the listener while a batch is alive is applied
+    // atomically when the outermost batch goes out of scope. Uses AL_SOFT_deferred_updates if it was loaded (see al::update),
+    // otherwise falls back to suspending and processing the context, which most implementations treat as a no-op, but at least it's the spec way.
+    // Deferring works on the current context, so the context passed in should be the current one.
+    class batch {
+    public:
+        AL_HPP_NODISCARD explicit batch(ALCcontext* context_ptr = nullptr, const al::dispatch* batch_dispatch = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                      : context_ptr_(context_ptr != nullptr ? context_ptr : AL_HPP_DISPATCHED(batch_dispatch, alc, getCurrentContext, alcGetCurrentContext)()),
+                                        dispatch_{batch_dispatch} {
+            // nested batches don't do anything, the outermost one commits
+            if(depth() > 0) {
+                ++depth();
+                return;
+            }
+
+            // the depth only goes up once deferring worked, a throwing check must not leave it raised for the thread
+            bool deferred = false;
+            LPALDEFERUPDATESSOFT defer_updates = AL_HPP_DISPATCHED(dispatch_, al, deferUpdatesSOFT, alDeferUpdatesSOFT);
+            if(defer_updates != nullptr) {
+                defer_updates();
+                deferred = al::util::check_al_error(dispatch_, "(deferring updates)") == al::errc::no_error;
+            } else {
+                AL_HPP_DISPATCHED(dispatch_, alc, suspendContext, alcSuspendContext)(context_ptr_);
+                deferred = al::util::check_alc_error(dispatch_, AL_HPP_DISPATCHED(dispatch_, alc, getContextsDevice, alcGetContextsDevice)(context_ptr_),
+                                                     "(suspending context)") == alc::errc::no_error;
+            }
+            if(!deferred) {
+                active_ = false;
+                return;
+            }
+            ++depth();
+        }
+
+        batch(const batch&) = delete;
+        batch& operator=(const batch&) = delete;
+
+        // movable so it can be returned from listener::batch(), the moved-from batch doesn't commit anymore
+        batch(batch&& old_batch) AL_HPP_NOEXCEPT : context_ptr_{old_batch.context_ptr_}, dispatch_{old_batch.dispatch_}, active_{old_batch.active_} {
+            old_batch.active_ = false;
+        }
+        batch& operator=(batch&&) = delete;
+
+        ~batch() AL_HPP_NOEXCEPT {
+            if(active_) commit();
+        }
+
+        // applies the changes before the end of the scope; later changes are no longer deferred
+        void commit() AL_HPP_NOEXCEPT {
+            if(!active_) return;
+            active_ = false;
+            if(--depth() > 0) return;
+
+            LPALPROCESSUPDATESSOFT process_updates = AL_HPP_DISPATCHED(dispatch_, al, processUpdatesSOFT, alProcessUpdatesSOFT);
+            if(process_updates != nullptr)
+                process_updates();
+            else
+                AL_HPP_DISPATCHED(dispatch_, alc, processContext, alcProcessContext)(context_ptr_);
+        }
+
+    private:
+        // contexts are bound per thread (at least with ALC_EXT_thread_local_context), so nesting is tracked per thread as well
+        static int& depth() AL_HPP_NOEXCEPT {
+            static thread_local int batch_depth = 0;
+            return batch_depth;
+        }
+
+        ALCcontext* context_ptr_;
+        const al::dispatch* dispatch_;
+        bool active_ = true;
+    };
+
+    namespace util {
+        // the context AL calls on this thread go to: the thread-local one if there is one, the process-wide one otherwise
+        AL_HPP_NODISCARD AL_HPP_INLINE ALCcontext* current_context(const al::dispatch* dispatch_ptr = nullptr) AL_HPP_NOEXCEPT {
+            PFNALCGETTHREADCONTEXTPROC get_thread_context = AL_HPP_DISPATCHED(dispatch_ptr, alc, getThreadContext, alcGetThreadContext);
+            ALCcontext* context_ptr = get_thread_context != nullptr ? get_thread_context() : nullptr;
+            return context_ptr != nullptr ? context_ptr : AL_HPP_DISPATCHED(dispatch_ptr, alc, getCurrentContext, alcGetCurrentContext)();
+        }
+
+        // makes context_ptr current for this thread only if ALC_EXT_thread_local_context was loaded (see al::update), for all threads otherwise
+        AL_HPP_INLINE bool bind_context(ALCcontext* context_ptr, const al::dispatch* dispatch_ptr = nullptr) AL_HPP_NOEXCEPT {
+            PFNALCSETTHREADCONTEXTPROC set_thread_context = AL_HPP_DISPATCHED(dispatch_ptr, alc, setThreadContext, alcSetThreadContext);
+            if(set_thread_context != nullptr)
+                return set_thread_context(context_ptr) == ALC_TRUE;
+            return AL_HPP_DISPATCHED(dispatch_ptr, alc, makeContextCurrent, alcMakeContextCurrent)(context_ptr) == ALC_TRUE;
+        }
+    }
+
+    // Binds a context to the current thread for the lifetime of the scope and restores the previous binding afterwards.
+    // With ALC_EXT_thread_local_context (loaded by al::update) the binding is per thread, so every thread can drive its own
+    // context without locking. Without it, this falls back to alcMakeContextCurrent, which is process-wide; then scopes on
+    // different threads step on each other and have to be serialized by the caller, see thread_local_binding().
+    class context_scope {
+    public:
+        AL_HPP_NODISCARD explicit context_scope(ALCcontext* context_ptr, const al::dispatch* scope_dispatch = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                              : dispatch_{scope_dispatch} {
+            PFNALCGETTHREADCONTEXTPROC get_thread_context = AL_HPP_DISPATCHED(dispatch_, alc, getThreadContext, alcGetThreadContext);
+            thread_local_ = get_thread_context != nullptr && AL_HPP_DISPATCHED(dispatch_, alc, setThreadContext, alcSetThreadContext) != nullptr;
+            previous_ptr_ = thread_local_ ? get_thread_context() : AL_HPP_DISPATCHED(dispatch_, alc, getCurrentContext, alcGetCurrentContext)();
+
+            if(!al::util::bind_context(context_ptr, dispatch_)) {
+                al::util::check_alc_error(dispatch_, nullptr, "(binding context)");
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: could not bind ALC context!");
+                active_ = false;
+                return;
+            }
+        }
+
+        context_scope(const context_scope&) = delete;
+        context_scope& operator=(const context_scope&) = delete;
+
+        context_scope(context_scope&& old_scope) AL_HPP_NOEXCEPT : dispatch_{old_scope.dispatch_}, previous_ptr_{old_scope.previous_ptr_},
+                                                                   thread_local_{old_scope.thread_local_}, active_{old_scope.active_} {
+            old_scope.active_ = false;
+        }
+        context_scope& operator=(context_scope&&) = delete;
+
+        ~context_scope() AL_HPP_NOEXCEPT {
+            if(!active_) return;
+            if(thread_local_)
+                AL_HPP_DISPATCHED(dispatch_, alc, setThreadContext, alcSetThreadContext)(previous_ptr_);
+            else
+                AL_HPP_DISPATCHED(dispatch_, alc, makeContextCurrent, alcMakeContextCurrent)(previous_ptr_);
+        }
+
+        // false if the fallback to the process-wide alcMakeContextCurrent was used
+        AL_HPP_NODISCARD bool thread_local_binding() const AL_HPP_NOEXCEPT { return thread_local_; }
+
+    private:
+        const al::dispatch* dispatch_;
+        ALCcontext* previous_ptr_ = nullptr;
+        bool thread_local_ = false;
+        bool active_ = true;
+    };
+
+    // What the object model does when it's used on a thread where its context isn't current, set with e.g. -DAL_HPP_CONTEXT_BINDING=bind:
+    //  none           - nothing, the calls go to whatever context is current (default, that's what plain OpenAL does)
+    //  assert_current - AL_HPP_ASSERT that the right context is current
+    //  bind           - bind the context to the thread, see al::util::bind_context
+    enum class context_binding {
+        none,
+        assert_current,
+        bind
+    };
+#if !defined( AL_HPP_CONTEXT_BINDING )
+#  define AL_HPP_CONTEXT_BINDING none
+#endif
+    AL_HPP_CONST_OR_CONSTEXPR context_binding default_context_binding = context_binding::AL_HPP_CONTEXT_BINDING;
+
+    // How to create, destroy and reset each kind of AL object, shared by everything that manages them generically.
+    // destroy takes an array so containers can delete all of their names with one call.
+    // reset puts a name back into the state a freshly generated one would be in, as far as AL allows.
+    namespace traits {
+        struct source {
+            using value_type = ALuint;
+
+            static void generate(const al::dispatch* dispatch, ALsizei count, ALuint* names) AL_HPP_NOEXCEPT {
+                AL_HPP_DISPATCHED(dispatch, al, genSources, alGenSources)(count, names);
+            }
+            static void destroy(const al::dispatch* dispatch, ALsizei count, const ALuint* names) AL_HPP_NOEXCEPT {
+                AL_HPP_DISPATCHED(dispatch, al, deleteSources, alDeleteSources)(count, names);
+            }
+            static void reset(const al::dispatch* dispatch, ALuint name) AL_HPP_NOEXCEPT {
+                struct default_value { ALenum parameter; float value; };
+                static const default_value float_defaults[] = {
+                    { AL_PITCH, 1.0f }, { AL_GAIN, 1.0f }, { AL_MIN_GAIN, 0.0f }, { AL_MAX_GAIN, 1.0f },
+                    { AL_MAX_DISTANCE, std::numeric_limits<float>::max() }, { AL_ROLLOFF_FACTOR, 1.0f }, { AL_REFERENCE_DISTANCE, 1.0f },
+                    { AL_CONE_OUTER_GAIN, 0.0f }, { AL_CONE_INNER_ANGLE, 360.0f }, { AL_CONE_OUTER_ANGLE, 360.0f }
+                };
+                static const ALenum vector_defaults[] = { AL_POSITION, AL_VELOCITY, AL_DIRECTION };
+
+                // rewinding a stopped source takes it back to AL_INITIAL
+                AL_HPP_DISPATCHED(dispatch, al, sourceStop, alSourceStop)(name);
+                AL_HPP_DISPATCHED(dispatch, al, sourceRewind, alSourceRewind)(name);
+                auto source_int = AL_HPP_DISPATCHED(dispatch, al, sourcei, alSourcei);
+                source_int(name, AL_BUFFER, 0);
+                source_int(name, AL_LOOPING, AL_FALSE);
+                source_int(name, AL_SOURCE_RELATIVE, AL_FALSE);
+                for(const default_value& reset_value : float_defaults)
+                    AL_HPP_DISPATCHED(dispatch, al, sourcef, alSourcef)(name, reset_value.parameter, reset_value.value);
+                for(ALenum parameter : vector_defaults)
+                    AL_HPP_DISPATCHED(dispatch, al, source3f, alSource3f)(name, parameter, 0.0f, 0.0f, 0.0f);
+
+                // the direct filter and the auxiliary sends only exist with EFX
+                ALCdevice* device_ptr = AL_HPP_DISPATCHED(dispatch, alc, getContextsDevice, alcGetContextsDevice)(al::util::current_context(dispatch));
+                if(device_ptr == nullptr || AL_HPP_DISPATCHED(dispatch, alc, isExtensionPresent, alcIsExtensionPresent)(device_ptr, "ALC_EXT_EFX") != ALC_TRUE)
+                    return;
+                ALCint sends = 0;
+                AL_HPP_DISPATCHED(dispatch, alc, getIntegerv, alcGetIntegerv)(device_ptr, ALC_MAX_AUXILIARY_SENDS, 1, &sends);
+                source_int(name, AL_DIRECT_FILTER, AL_FILTER_NULL);
+                for(ALCint send = 0; send < sends; ++send)
+                    AL_HPP_DISPATCHED(dispatch, al, source3i, alSource3i)(name, AL_AUXILIARY_SEND_FILTER, AL_EFFECTSLOT_NULL, send, AL_FILTER_NULL);
+            }
+        };
+
+        struct buffer {
+            using value_type = ALuint;
+
+            static void generate(const al::dispatch* dispatch, ALsizei count, ALuint* names) AL_HPP_NOEXCEPT {
+                AL_HPP_DISPATCHED(dispatch, al, genBuffers, alGenBuffers)(count, names);
+            }
+            static void destroy(const al::dispatch* dispatch, ALsizei count, const ALuint* names) AL_HPP_NOEXCEPT {
+                AL_HPP_DISPATCHED(dispatch, al, deleteBuffers, alDeleteBuffers)(count, names);
+            }
+            // a buffer's only state is its data, and the next upload replaces that
+            static void reset(const al::dispatch*, ALuint) AL_HPP_NOEXCEPT {}
+        };
+
+        struct effect {
+            using value_type = ALuint;
+
+            static void generate(const al::dispatch* dispatch, ALsizei count, ALuint* names) AL_HPP_NOEXCEPT {
+                AL_HPP_DISPATCHED(dispatch, al, genEffects, alGenEffects)(count, names);
+            }
+            static void destroy(const al::dispatch* dispatch, ALsizei count, const ALuint* names) AL_HPP_NOEXCEPT {
+                AL_HPP_DISPATCHED(dispatch, al, deleteEffects, alDeleteEffects)(count, names);
+            }
+            // changing the type resets every parameter of the effect
+            static void reset(const al::dispatch* dispatch, ALuint name) AL_HPP_NOEXCEPT {
+                AL_HPP_DISPATCHED(dispatch, al, effecti, alEffecti)(name, AL_EFFECT_TYPE, AL_EFFECT_NULL);
+            }
+        };
+
+        struct filter {
+            using value_type = ALuint;
+
+            static void generate(const al::dispatch* dispatch, ALsizei count, ALuint* names) AL_HPP_NOEXCEPT {
+                AL_HPP_DISPATCHED(dispatch, al, genFilters, alGenFilters)(count, names);
+            }
+            static void destroy(const al::dispatch* dispatch, ALsizei count, const ALuint* names) AL_HPP_NOEXCEPT {
+                AL_HPP_DISPATCHED(dispatch, al, deleteFilters, alDeleteFilters)(count, names);
+            }
+            static void reset(const al::dispatch* dispatch, ALuint name) AL_HPP_NOEXCEPT {
+                AL_HPP_DISPATCHED(dispatch, al, filteri, alFilteri)(name, AL_FILTER_TYPE, AL_FILTER_NULL);
+            }
+        };
+
+        struct effect_slot {
+            using value_type = ALuint;
+
+            static void generate(const al::dispatch* dispatch, ALsizei count, ALuint* names) AL_HPP_NOEXCEPT {
+                AL_HPP_DISPATCHED(dispatch, al, genAuxiliaryEffectSlots, alGenAuxiliaryEffectSlots)(count, names);
+            }
+            static void destroy(const al::dispatch* dispatch, ALsizei count, const ALuint* names) AL_HPP_NOEXCEPT {
+                AL_HPP_DISPATCHED(dispatch, al, deleteAuxiliaryEffectSlots, alDeleteAuxiliaryEffectSlots)(count, names);
+            }
+            static void reset(const al::dispatch* dispatch, ALuint name) AL_HPP_NOEXCEPT {
+                auto slot_int = AL_HPP_DISPATCHED(dispatch, al, auxiliaryEffectSloti, alAuxiliaryEffectSloti);
+                slot_int(name, AL_EFFECTSLOT_EFFECT, AL_EFFECT_NULL);
+                slot_int(name, AL_EFFECTSLOT_AUXILIARY_SEND_AUTO, AL_TRUE);
+                AL_HPP_DISPATCHED(dispatch, al, auxiliaryEffectSlotf, alAuxiliaryEffectSlotf)(name, AL_EFFECTSLOT_GAIN, 1.0f);
+            }
+        };
+
+        // ALC has no array versions, so these destroy one after the other
+        struct device {
+            using value_type = ALCdevice*;
+
+            static void destroy(const al::dispatch* dispatch, ALsizei count, const value_type* devices) AL_HPP_NOEXCEPT {
+                for(ALsizei i = 0; i < count; ++i)
+                    AL_HPP_DISPATCHED(dispatch, alc, closeDevice, alcCloseDevice)(devices[i]);
+            }
+        };
+
+        struct context {
+            using value_type = ALCcontext*;
+
+            // a context that is still current can't be destroyed
+            static void destroy(const al::dispatch* dispatch, ALsizei count, const value_type* contexts) AL_HPP_NOEXCEPT {
+                for(ALsizei i = 0; i < count; ++i) {
+                    if(al::util::current_context(dispatch) == contexts[i])
+                        al::util::bind_context(nullptr, dispatch);
+                    if(AL_HPP_DISPATCHED(dispatch, alc, getCurrentContext, alcGetCurrentContext)() == contexts[i])
+                        AL_HPP_DISPATCHED(dispatch, alc, makeContextCurrent, alcMakeContextCurrent)(nullptr);
+                    AL_HPP_DISPATCHED(dispatch, alc, destroyContext, alcDestroyContext)(contexts[i]);
+                }
+            }
+        };
+    }
+
+    // Owns a single AL object of one kind (see al::traits), e.g. al::handle<al::traits::buffer>. Moving is a pointer swap
+    // and never throws, so containers of handles reallocate without copying, and al::destroy deletes a whole container of
+    // them with one call. The dispatch, if any, has to outlive the handle.
+    template<typename Traits>
+    class handle {
+    public:
+        using traits_type = Traits;
+        using value_type = typename Traits::value_type;
+
+        handle() = default;
+        AL_HPP_NODISCARD explicit handle(value_type value, const al::dispatch* handle_dispatch = nullptr) AL_HPP_NOEXCEPT
+                                        : value_{value}, dispatch_{handle_dispatch} {}
+
+        handle(const handle&) = delete;
+        handle& operator=(const handle&) = delete;
+
+        handle(handle&& old_handle) AL_HPP_NOEXCEPT : value_{old_handle.value_}, dispatch_{old_handle.dispatch_} {
+            old_handle.value_ = value_type();
+        }
+        handle& operator=(handle&& old_handle) AL_HPP_NOEXCEPT {
+            if(this != &old_handle) {
+                reset(old_handle.value_, old_handle.dispatch_);
+                old_handle.value_ = value_type();
+            }
+            return *this;
+        }
+
+        ~handle() AL_HPP_NOEXCEPT { reset(); }
+
+        // generates a new name, only for kinds that have generate; returns an empty handle on failure
+        AL_HPP_NODISCARD static handle generate(const al::dispatch* handle_dispatch = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            value_type value = value_type();
+            Traits::generate(handle_dispatch, 1, &value);
+            if(al::util::check_al_error(handle_dispatch, "(generating handle)") != al::no_error) return handle();
+            return handle(value, handle_dispatch);
+        }
+
+        // destroys the held object and takes over value
+        void reset(value_type value = value_type(), const al::dispatch* handle_dispatch = nullptr) AL_HPP_NOEXCEPT {
+            if(value_ != value_type())
+                Traits::destroy(dispatch_, 1, &value_);
+            value_ = value;
+            dispatch_ = handle_dispatch;
+        }
+
+        // gives up ownership without destroying
+        AL_HPP_NODISCARD value_type release() AL_HPP_NOEXCEPT {
+            value_type value = value_;
+            value_ = value_type();
+            return value;
+        }
+
+        AL_HPP_NODISCARD value_type get() const AL_HPP_NOEXCEPT { return value_; }
+        AL_HPP_NODISCARD const al::dispatch* dispatch_ptr() const AL_HPP_NOEXCEPT { return dispatch_; }
+        AL_HPP_NODISCARD explicit operator bool() const AL_HPP_NOEXCEPT { return value_ != value_type(); }
+
+    private:
+        value_type value_ = value_type();
+        const al::dispatch* dispatch_ = nullptr;
+    };
+
+    // destroys count handles with as few calls as possible: one per run of handles sharing a dispatch
+    template<typename Traits>
+    void destroy(al::handle<Traits>* handles, std::size_t count) AL_HPP_NOEXCEPT {
+        using value_type = typename Traits::value_type;
+        std::vector<value_type> values;
+        values.reserve(count);
+        std::size_t i = 0;
+        while(i < count) {
+            const al::dispatch* run_dispatch = handles[i].dispatch_ptr();
+            values.clear();
+            for(; i < count && handles[i].dispatch_ptr() == run_dispatch; ++i)
+                if(handles[i]) values.push_back(handles[i].release());
+            if(!values.empty())
+                Traits::destroy(run_dispatch, static_cast<ALsizei>(values.size()), values.data());
+        }
+    }
+    template<typename Traits>
+    void destroy(std::vector<al::handle<Traits>>& handles) AL_HPP_NOEXCEPT {
+        al::destroy(handles.data(), handles.size());
+        handles.clear();
+    }
+
+    // An AL buffer and what was uploaded into it. The typed from() and data() pick the format at compile time from the sample
+    // type and channel layout, and pass the caller's memory straight to alBufferData.
     class buffer {
     public:
-    
-        AL_HPP_NODISCARD buffer(device buffer_device) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        // no AL buffer yet, see generate() and from()
+        buffer() = default;
+
+        AL_HPP_NODISCARD static buffer generate(const al::dispatch* buffer_dispatch = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            buffer generated;
+            generated.handle_ = al::handle<al::traits::buffer>::generate(buffer_dispatch);
+            return generated;
+        }
+
+        // samples holds frames interleaved frames, e.g. from(samples, frames, al::channels<2>(), 48000) for stereo16 with int16_t samples
+        template<typename Sample, typename Layout>
+        AL_HPP_NODISCARD static buffer from(const Sample* samples, std::size_t frames, Layout layout, ALsizei frequency,
+                                            const al::dispatch* buffer_dispatch = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            buffer uploaded = generate(buffer_dispatch);
+            if(uploaded) uploaded.data(samples, frames, layout, frequency);
+            return uploaded;
+        }
+#if defined( AL_HPP_SUPPORT_SPAN )
+        template<typename Sample, std::size_t Extent, typename Layout>
+        AL_HPP_NODISCARD static buffer from(std::span<Sample, Extent> samples, Layout layout, ALsizei frequency,
+                                            const al::dispatch* buffer_dispatch = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            AL_HPP_CONST_OR_CONSTEXPR std::size_t channel_count = al::describe(al::format_of<typename std::remove_const<Sample>::type, Layout>::value).channels;
+            static_assert(Extent == std::dynamic_extent || Extent % channel_count == 0, "the samples don't make up whole frames");
+            return from(samples.data(), samples.size() / channel_count, layout, frequency, buffer_dispatch);
+        }
+#endif
+
+        // replaces the contents, the format follows from Sample and Layout
+        template<typename Sample, typename Layout>
+        void data(const Sample* samples, std::size_t frames, Layout, ALsizei frequency) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            AL_HPP_CONST_OR_CONSTEXPR al::format sample_format = al::format_of<typename std::remove_const<Sample>::type, Layout>::value;
+            static_assert(sizeof(Sample) == al::sample_bytes(al::describe(sample_format).encoding), "the sample type doesn't match its format");
+            // AL takes the size as ALsizei, checked before multiplying so the product can't wrap either
+            if(frames > static_cast<std::size_t>(std::numeric_limits<ALsizei>::max()) / al::frame_bytes(sample_format)) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: too many samples for a single buffer!");
+                return;
+            }
+            data(sample_format, samples, static_cast<ALsizei>(frames * al::frame_bytes(sample_format)), frequency);
+        }
+#if defined( AL_HPP_SUPPORT_SPAN )
+        template<typename Sample, std::size_t Extent, typename Layout>
+        void data(std::span<Sample, Extent> samples, Layout layout, ALsizei frequency) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            AL_HPP_CONST_OR_CONSTEXPR std::size_t channel_count = al::describe(al::format_of<typename std::remove_const<Sample>::type, Layout>::value).channels;
+            static_assert(Extent == std::dynamic_extent || Extent % channel_count == 0, "the samples don't make up whole frames");
+            data(samples.data(), samples.size() / channel_count, layout, frequency);
+        }
+#endif
+        // untyped version, for formats only known at runtime; size is in bytes
+        void data(al::format sample_format, const void* samples, ALsizei size, ALsizei frequency) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            set_block_align(0);
+            upload(sample_format, samples, size, frequency);
+        }
 
+        // Uploads IMA4 or MSADPCM blocks as they are, the mixer decodes them while playing. block_align is in sample frames
+        // per block and goes through AL_SOFT_block_alignment, 0 is the implementation's default (65 for IMA4, 64 for MSADPCM).
+        AL_HPP_NODISCARD static buffer from(const al::compressed_samples& samples, const al::dispatch* buffer_dispatch = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            // AL takes the size as ALsizei, checked before generating so nothing is left behind
+            if(samples.blocks.size() > static_cast<std::size_t>(std::numeric_limits<ALsizei>::max())) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: too many compressed blocks for a single buffer!");
+                return buffer();
+            }
+            buffer uploaded = generate(buffer_dispatch);
+            if(uploaded) uploaded.compressed_data(samples.format, samples.blocks.data(), static_cast<ALsizei>(samples.blocks.size()), samples.block_align, samples.frequency);
+            return uploaded;
+        }
+        void compressed_data(al::format sample_format, const void* blocks, ALsizei size, ALsizei block_align, ALsizei frequency) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            AL_HPP_ASSERT(al::is_compressed(sample_format));
+            set_block_align(block_align);
+            upload(sample_format, blocks, size, frequency);
+        }
+
+        // returns the name of the buffer, non-owning
+        AL_HPP_NODISCARD ALuint       buffer_id() const AL_HPP_NOEXCEPT { return handle_.get(); }
+        AL_HPP_NODISCARD al::format   format()    const AL_HPP_NOEXCEPT { return format_; }
+        AL_HPP_NODISCARD ALsizei      frequency() const AL_HPP_NOEXCEPT { return frequency_; }
+        // bytes uploaded
+        AL_HPP_NODISCARD ALsizei      size()      const AL_HPP_NOEXCEPT { return size_; }
+        AL_HPP_NODISCARD std::size_t  channels()  const AL_HPP_NOEXCEPT { return al::describe(format_).channels; }
+        // 0 for the block compressed formats
+        AL_HPP_NODISCARD std::size_t  frames()    const AL_HPP_NOEXCEPT {
+            return al::frame_bytes(format_) != 0 ? static_cast<std::size_t>(size_) / al::frame_bytes(format_) : 0;
         }
+        // sample frames per block for the compressed formats, 0 for the default
+        AL_HPP_NODISCARD ALsizei      block_align() const AL_HPP_NOEXCEPT { return block_align_; }
+        AL_HPP_NODISCARD explicit operator bool() const AL_HPP_NOEXCEPT { return static_cast<bool>(handle_); }
 
     private:
+        // the unpack alignment sticks to the buffer, so it's only set when it changes
+        void set_block_align(ALsizei block_align) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(block_align == block_align_) return;
+            AL_HPP_DISPATCHED(handle_.dispatch_ptr(), al, bufferi, alBufferi)(handle_.get(), AL_UNPACK_BLOCK_ALIGNMENT_SOFT, block_align);
+            if(al::util::check_al_error(handle_.dispatch_ptr(), "(setting block alignment)") == al::no_error) block_align_ = block_align;
+        }
 
-        ALuint buffer_id;
-        al::format format;
-        ALuint bits, channels;
-        const void* data;
-        ALsizei size;
-        float frequency;
+        void upload(al::format sample_format, const void* samples, ALsizei size, ALsizei frequency) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            AL_HPP_DISPATCHED(handle_.dispatch_ptr(), al, bufferData, alBufferData)(handle_.get(), sample_format, samples, size, frequency);
+            if(al::util::check_al_error(handle_.dispatch_ptr(), "(uploading buffer data)") != al::no_error) return;
+            format_ = sample_format;
+            size_ = size;
+            frequency_ = frequency;
+        }
+
+        al::handle<al::traits::buffer> handle_;
+        al::format format_ = al::format::mono16;
+        ALsizei size_ = 0;
+        ALsizei frequency_ = 0;
+        ALsizei block_align_ = 0;
     };
 
+
     // The nomenclature is really confusing here, "Listener" is also called "Context", as the context depends on the device, and there is only one listener per context
     // We manage the context in the listener since creating a new listener also automatically involves creating a new context
     // Also, the distance model is clearly part of the Listener, therefore its stored here.
@@ -1028,43 +2268,189 @@ namespace al {
     class listener {
     public:
     
-        AL_HPP_NODISCARD listener(al::device listener_device) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
-            // TODO: handle attributes (second argument)
-            context_ptr_ = alc::createContext(listener_device.device_ptr(), nullptr);
+        // attributes is a zero-terminated list of ALC attribute/value pairs, see loopback_device::attributes() for an example
+        // a listener on a device opened with a dispatch is bound to the same dispatch.
+        // the device's AL information (vendor, AL extensions, ...) is filled in once the context is current
+        AL_HPP_NODISCARD listener(al::device& listener_device, const ALCint* attributes = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                 : dispatch_{listener_device.dispatch_ptr()} {
+            context_.reset(AL_HPP_DISPATCHED(dispatch_, alc, createContext, alcCreateContext)(listener_device.device_ptr(), attributes), dispatch_);
             listener_device.check("(creating ALC context)");
-            if(context_ptr_ == nullptr) {
+            if(context_.get() == nullptr) {
                 AL_HPP_THROW_WHEN_EXCEPTIONS("Error: could not create ALC context!");
                 return;
             }
-            ALCboolean code = alc::makeContextCurrent(context_ptr_);
+            ALCboolean code = AL_HPP_DISPATCHED(dispatch_, alc, makeContextCurrent, alcMakeContextCurrent)(context_.get());
             listener_device.check("(making ALC context current)");
             if(!code) {
                 AL_HPP_THROW_WHEN_EXCEPTIONS("Error: could not make ALC context current!");
                 return;
             }
+            listener_device.update_context_info();
+
+            // the context attributes can't change, so they're only queried once
+            auto get_integer = AL_HPP_DISPATCHED(dispatch_, alc, getIntegerv, alcGetIntegerv);
+            ALCint sync = ALC_FALSE;
+            get_integer(listener_device.device_ptr(), ALC_FREQUENCY, 1, &frequency_);
+            get_integer(listener_device.device_ptr(), ALC_REFRESH, 1, &refresh_);
+            get_integer(listener_device.device_ptr(), ALC_SYNC, 1, &sync);
+            get_integer(listener_device.device_ptr(), ALC_MONO_SOURCES, 1, &mono_sources_);
+            get_integer(listener_device.device_ptr(), ALC_STEREO_SOURCES, 1, &stereo_sources_);
+            listener_device.check("(querying context attributes)");
+            sync_ = sync == ALC_TRUE;
+        }
+
+        // sources point to their listener, and the shadow state must not be duplicated
+        listener(const listener&) = delete;
+        listener& operator=(const listener&) = delete;
+
+        // defers all changes to this listener's context until the returned batch goes out of scope
+        AL_HPP_NODISCARD al::batch batch() const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            ensure_current();
+            return al::batch(context_.get(), dispatch_);
+        }
+
+        // binds this listener's context to the calling thread until the returned scope ends
+        AL_HPP_NODISCARD al::context_scope scope() const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            return al::context_scope(context_.get(), dispatch_);
+        }
+
+        AL_HPP_NODISCARD bool is_current() const AL_HPP_NOEXCEPT {
+            return al::util::current_context(dispatch_) == context_.get();
+        }
+
+        // applies the context binding policy, called before everything that goes to this listener's context
+        template<al::context_binding Binding = al::default_context_binding>
+        void ensure_current() const AL_HPP_NOEXCEPT {
+            switch(Binding) {
+                case al::context_binding::none: return;
+                case al::context_binding::assert_current: AL_HPP_ASSERT(is_current()); return;
+                case al::context_binding::bind: if(!is_current()) al::util::bind_context(context_.get(), dispatch_); return;
+            }
+        }
+
+        AL_HPP_NODISCARD const al::dispatch* dispatch_ptr() const AL_HPP_NOEXCEPT { return dispatch_; }
+        // returns non-owning pointer
+        AL_HPP_NODISCARD ALCcontext* context_ptr() const AL_HPP_NOEXCEPT { return context_.get(); }
+
+        // setters only go to AL if the value changed
+        void set_gain(float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS { set(AL_GAIN, gain_, value); }
+        void set_position(al::vec3 value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS { set(AL_POSITION, position_, value); }
+        void set_velocity(al::vec3 value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS { set(AL_VELOCITY, velocity_, value); }
+        void set_orientation(al::vec3 forward, al::vec3 up) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(forward == forward_direction_ && up == up_direction_) return;
+            ensure_current();
+            const ALfloat orientation[6] = { forward.x, forward.y, forward.z, up.x, up.y, up.z };
+            AL_HPP_DISPATCHED(dispatch_, al, listenerfv, alListenerfv)(AL_ORIENTATION, orientation);
+            if(al::util::check_al_error(dispatch_, "(setting listener orientation)") != al::no_error) return;
+            forward_direction_ = forward;
+            up_direction_ = up;
+        }
+        void set_doppler_factor(float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            set_global(doppler_factor_, value, AL_HPP_DISPATCHED(dispatch_, al, dopplerFactor, alDopplerFactor));
+        }
+        void set_doppler_velocity(float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            set_global(doppler_velocity_, value, AL_HPP_DISPATCHED(dispatch_, al, dopplerVelocity, alDopplerVelocity));
+        }
+        void set_speed_of_sound(float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            set_global(speed_of_sound_, value, AL_HPP_DISPATCHED(dispatch_, al, speedOfSound, alSpeedOfSound));
+        }
+        void set_distance_model(al::distance_model value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(value == model_) return;
+            ensure_current();
+            AL_HPP_DISPATCHED(dispatch_, al, distanceModel, alDistanceModel)(static_cast<ALenum>(value));
+            if(al::util::check_al_error(dispatch_, "(setting distance model)") == al::no_error) model_ = value;
+        }
 
+        // served from the shadow state
+        AL_HPP_NODISCARD float gain() const AL_HPP_NOEXCEPT { shadow_check(AL_GAIN, gain_); return gain_; }
+        AL_HPP_NODISCARD al::vec3 position() const AL_HPP_NOEXCEPT { shadow_check(AL_POSITION, position_); return position_; }
+        AL_HPP_NODISCARD al::vec3 velocity() const AL_HPP_NOEXCEPT { shadow_check(AL_VELOCITY, velocity_); return velocity_; }
+        AL_HPP_NODISCARD al::vec3 forward_direction() const AL_HPP_NOEXCEPT { return forward_direction_; }
+        AL_HPP_NODISCARD al::vec3 up_direction() const AL_HPP_NOEXCEPT { return up_direction_; }
+        AL_HPP_NODISCARD float doppler_factor() const AL_HPP_NOEXCEPT { return doppler_factor_; }
+        AL_HPP_NODISCARD float doppler_velocity() const AL_HPP_NOEXCEPT { return doppler_velocity_; }
+        AL_HPP_NODISCARD float speed_of_sound() const AL_HPP_NOEXCEPT { return speed_of_sound_; }
+        AL_HPP_NODISCARD al::distance_model model() const AL_HPP_NOEXCEPT { return model_; }
+
+        // context attributes
+        AL_HPP_NODISCARD int frequency() const AL_HPP_NOEXCEPT { return frequency_; }
+        AL_HPP_NODISCARD int refresh() const AL_HPP_NOEXCEPT { return refresh_; }
+        AL_HPP_NODISCARD bool sync() const AL_HPP_NOEXCEPT { return sync_; }
+        AL_HPP_NODISCARD int mono_sources() const AL_HPP_NOEXCEPT { return mono_sources_; }
+        AL_HPP_NODISCARD int stereo_sources() const AL_HPP_NOEXCEPT { return stereo_sources_; }
+
+        // compares the whole shadow state with the implementation, false if anything differs
+        AL_HPP_NODISCARD bool verify() const AL_HPP_NOEXCEPT {
+            ALfloat orientation[6] = {};
+            AL_HPP_DISPATCHED(dispatch_, al, getListenerfv, alGetListenerfv)(AL_ORIENTATION, orientation);
+            auto get_float = AL_HPP_DISPATCHED(dispatch_, al, getFloat, alGetFloat);
+            return matches(AL_GAIN, gain_) && matches(AL_POSITION, position_) && matches(AL_VELOCITY, velocity_)
+                && al::vec3 { orientation[0], orientation[1], orientation[2] } == forward_direction_
+                && al::vec3 { orientation[3], orientation[4], orientation[5] } == up_direction_
+                && get_float(AL_DOPPLER_FACTOR) == doppler_factor_ && get_float(AL_DOPPLER_VELOCITY) == doppler_velocity_
+                && get_float(AL_SPEED_OF_SOUND) == speed_of_sound_
+                && AL_HPP_DISPATCHED(dispatch_, al, getInteger, alGetInteger)(AL_DISTANCE_MODEL) == static_cast<ALint>(model_);
         }
 
     private:
-        ALCcontext* context_ptr_;
+        void set(ALenum parameter, float& shadow, float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(value == shadow) return;
+            ensure_current();
+            AL_HPP_DISPATCHED(dispatch_, al, listenerf, alListenerf)(parameter, value);
+            if(al::util::check_al_error(dispatch_, "(setting listener property)") == al::no_error) shadow = value;
+        }
+        void set(ALenum parameter, al::vec3& shadow, al::vec3 value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(value == shadow) return;
+            ensure_current();
+            AL_HPP_DISPATCHED(dispatch_, al, listener3f, alListener3f)(parameter, value.x, value.y, value.z);
+            if(al::util::check_al_error(dispatch_, "(setting listener property)") == al::no_error) shadow = value;
+        }
+        template<typename F>
+        void set_global(float& shadow, float value, F setter) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(value == shadow) return;
+            ensure_current();
+            setter(value);
+            if(al::util::check_al_error(dispatch_, "(setting context property)") == al::no_error) shadow = value;
+        }
+
+        bool matches(ALenum parameter, float shadow) const AL_HPP_NOEXCEPT {
+            ALfloat value = 0.0f;
+            AL_HPP_DISPATCHED(dispatch_, al, getListenerf, alGetListenerf)(parameter, &value);
+            return value == shadow;
+        }
+        bool matches(ALenum parameter, al::vec3 shadow) const AL_HPP_NOEXCEPT {
+            al::vec3 value { 0.0f, 0.0f, 0.0f };
+            AL_HPP_DISPATCHED(dispatch_, al, getListener3f, alGetListener3f)(parameter, &value.x, &value.y, &value.z);
+            return value == shadow;
+        }
+        template<typename T>
+        void shadow_check(ALenum parameter, const T& shadow) const AL_HPP_NOEXCEPT {
+#if defined( AL_HPP_SHADOW_STATE_CHECKS )
+            AL_HPP_ASSERT(matches(parameter, shadow));
+#else
+            (void)parameter;
+            (void)shadow;
+#endif
+        }
 
-        int frequency, refresh;
-        bool sync;
-        int mono_sources, stereo_sources;
-        float doppler_factor, doppler_velocity, speed_of_sound;
-        al::distance_model model;
+        // destroyed with the listener
+        al::handle<al::traits::context> context_;
+        const al::dispatch* dispatch_;
 
-        float gain;
-        al::vec3 position, velocity, forward_direction, up_direction;
+        // everything starts out with the AL defaults
+        ALCint frequency_ = 0, refresh_ = 0;
+        bool sync_ = false;
+        ALCint mono_sources_ = 0, stereo_sources_ = 0;
+        float doppler_factor_ = 1.0f, doppler_velocity_ = 1.0f, speed_of_sound_ = 343.3f;
+        al::distance_model model_ = al::distance_model::inverse_clamped;
+
+        float gain_ = 1.0f;
+        al::vec3 position_ { 0.0f, 0.0f, 0.0f }, velocity_ { 0.0f, 0.0f, 0.0f };
+        al::vec3 forward_direction_ { 0.0f, 0.0f, -1.0f }, up_direction_ { 0.0f, 1.0f, 0.0f };
     };
 
     class source {
     public:
-    
-        AL_HPP_NODISCARD source(listener listener_source) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
-            
-        }
-
         enum type {
             undetermined = AL_UNDETERMINED,
             //clunky name because AL uses a keyword ("static") as an identifier...
@@ -1079,25 +2465,2962 @@ namespace al {
             stopped = AL_STOPPED
         };
 
+        // the listener has to outlive the source
+        AL_HPP_NODISCARD explicit source(const al::listener& source_listener) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                        : listener_{&source_listener}, dispatch_{source_listener.dispatch_ptr()} {
+            listener_->ensure_current();
+            AL_HPP_DISPATCHED(dispatch_, al, genSources, alGenSources)(1, &source_id_);
+            al::util::check_al_error(dispatch_, "(generating source)");
+        }
+
+        source(const source&) = delete;
+        source& operator=(const source&) = delete;
+
+        ~source() AL_HPP_NOEXCEPT {
+            if(source_id_ != 0)
+                AL_HPP_DISPATCHED(dispatch_, al, deleteSources, alDeleteSources)(1, &source_id_);
+        }
+
+        // returns the name of the source, non-owning
+        AL_HPP_NODISCARD ALuint source_id() const AL_HPP_NOEXCEPT { return source_id_; }
+
+        // setters only go to AL if the value changed
+        void set_pitch(float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS              { set(AL_PITCH, pitch_, value); }
+        void set_gain(float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS               { set(AL_GAIN, gain_, value); }
+        void set_max_distance(float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS       { set(AL_MAX_DISTANCE, max_distance_, value); }
+        void set_rolloff_factor(float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS     { set(AL_ROLLOFF_FACTOR, rolloff_factor_, value); }
+        void set_reference_distance(float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS { set(AL_REFERENCE_DISTANCE, reference_distance_, value); }
+        void set_min_gain(float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS           { set(AL_MIN_GAIN, min_gain_, value); }
+        void set_max_gain(float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS           { set(AL_MAX_GAIN, max_gain_, value); }
+        void set_cone_outer_gain(float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS    { set(AL_CONE_OUTER_GAIN, cone_outer_gain_, value); }
+        void set_cone_inner_angle(float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS   { set(AL_CONE_INNER_ANGLE, cone_inner_angle_, value); }
+        void set_cone_outer_angle(float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS   { set(AL_CONE_OUTER_ANGLE, cone_outer_angle_, value); }
+        void set_position(al::vec3 value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS        { set(AL_POSITION, position_, value); }
+        void set_velocity(al::vec3 value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS        { set(AL_VELOCITY, velocity_, value); }
+        void set_direction(al::vec3 value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS       { set(AL_DIRECTION, direction_, value); }
+        void set_relative(bool value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS            { set(AL_SOURCE_RELATIVE, source_relative_, value ? AL_TRUE : AL_FALSE); }
+        void set_looping(bool value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS             { set(AL_LOOPING, looping_, value ? AL_TRUE : AL_FALSE); }
+        // attaches a single buffer, 0 detaches everything; also resets queued buffers
+        void set_buffer(ALuint buffer_id) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(buffer_id == current_buffer_id_ && buffer_id != 0) return;
+            listener_->ensure_current();
+            AL_HPP_DISPATCHED(dispatch_, al, sourcei, alSourcei)(source_id_, AL_BUFFER, static_cast<ALint>(buffer_id));
+            if(al::util::check_al_error(dispatch_, "(setting source buffer)") == al::no_error) current_buffer_id_ = buffer_id;
+        }
+
+        // served from the shadow state
+        AL_HPP_NODISCARD float pitch() const AL_HPP_NOEXCEPT              { return cached(AL_PITCH, pitch_); }
+        AL_HPP_NODISCARD float gain() const AL_HPP_NOEXCEPT               { return cached(AL_GAIN, gain_); }
+        AL_HPP_NODISCARD float max_distance() const AL_HPP_NOEXCEPT       { return cached(AL_MAX_DISTANCE, max_distance_); }
+        AL_HPP_NODISCARD float rolloff_factor() const AL_HPP_NOEXCEPT     { return cached(AL_ROLLOFF_FACTOR, rolloff_factor_); }
+        AL_HPP_NODISCARD float reference_distance() const AL_HPP_NOEXCEPT { return cached(AL_REFERENCE_DISTANCE, reference_distance_); }
+        AL_HPP_NODISCARD float min_gain() const AL_HPP_NOEXCEPT           { return cached(AL_MIN_GAIN, min_gain_); }
+        AL_HPP_NODISCARD float max_gain() const AL_HPP_NOEXCEPT           { return cached(AL_MAX_GAIN, max_gain_); }
+        AL_HPP_NODISCARD float cone_outer_gain() const AL_HPP_NOEXCEPT    { return cached(AL_CONE_OUTER_GAIN, cone_outer_gain_); }
+        AL_HPP_NODISCARD float cone_inner_angle() const AL_HPP_NOEXCEPT   { return cached(AL_CONE_INNER_ANGLE, cone_inner_angle_); }
+        AL_HPP_NODISCARD float cone_outer_angle() const AL_HPP_NOEXCEPT   { return cached(AL_CONE_OUTER_ANGLE, cone_outer_angle_); }
+        AL_HPP_NODISCARD al::vec3 position() const AL_HPP_NOEXCEPT        { return cached(AL_POSITION, position_); }
+        AL_HPP_NODISCARD al::vec3 velocity() const AL_HPP_NOEXCEPT        { return cached(AL_VELOCITY, velocity_); }
+        AL_HPP_NODISCARD al::vec3 direction() const AL_HPP_NOEXCEPT       { return cached(AL_DIRECTION, direction_); }
+        AL_HPP_NODISCARD bool relative() const AL_HPP_NOEXCEPT            { return cached(AL_SOURCE_RELATIVE, source_relative_) == AL_TRUE; }
+        AL_HPP_NODISCARD bool looping() const AL_HPP_NOEXCEPT             { return cached(AL_LOOPING, looping_) == AL_TRUE; }
+
+        // these change while the source plays, so they are always asked for
+        AL_HPP_NODISCARD state current_state() const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS { return static_cast<state>(query(AL_SOURCE_STATE)); }
+        AL_HPP_NODISCARD type current_type() const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS { return static_cast<type>(query(AL_SOURCE_TYPE)); }
+        AL_HPP_NODISCARD ALint buffers_queued() const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS { return query(AL_BUFFERS_QUEUED); }
+        AL_HPP_NODISCARD ALint buffers_processed() const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS { return query(AL_BUFFERS_PROCESSED); }
+        AL_HPP_NODISCARD float sec_offset() const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS { return query_float(AL_SEC_OFFSET); }
+        AL_HPP_NODISCARD float sample_offset() const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS { return query_float(AL_SAMPLE_OFFSET); }
+        AL_HPP_NODISCARD float byte_offset() const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS { return query_float(AL_BYTE_OFFSET); }
+        void set_sec_offset(float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            listener_->ensure_current();
+            AL_HPP_DISPATCHED(dispatch_, al, sourcef, alSourcef)(source_id_, AL_SEC_OFFSET, value);
+            al::util::check_al_error(dispatch_, "(setting source offset)");
+        }
+
+        void play() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS   { command(AL_HPP_DISPATCHED(dispatch_, al, sourcePlay, alSourcePlay), "(playing source)"); }
+        void pause() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS  { command(AL_HPP_DISPATCHED(dispatch_, al, sourcePause, alSourcePause), "(pausing source)"); }
+        void stop() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS   { command(AL_HPP_DISPATCHED(dispatch_, al, sourceStop, alSourceStop), "(stopping source)"); }
+        void rewind() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS { command(AL_HPP_DISPATCHED(dispatch_, al, sourceRewind, alSourceRewind), "(rewinding source)"); }
+
+        // compares the whole shadow state with the implementation, false if anything differs
+        AL_HPP_NODISCARD bool verify() const AL_HPP_NOEXCEPT {
+            return matches(AL_PITCH, pitch_) && matches(AL_GAIN, gain_) && matches(AL_MAX_DISTANCE, max_distance_)
+                && matches(AL_ROLLOFF_FACTOR, rolloff_factor_) && matches(AL_REFERENCE_DISTANCE, reference_distance_)
+                && matches(AL_MIN_GAIN, min_gain_) && matches(AL_MAX_GAIN, max_gain_) && matches(AL_CONE_OUTER_GAIN, cone_outer_gain_)
+                && matches(AL_CONE_INNER_ANGLE, cone_inner_angle_) && matches(AL_CONE_OUTER_ANGLE, cone_outer_angle_)
+                && matches(AL_POSITION, position_) && matches(AL_VELOCITY, velocity_) && matches(AL_DIRECTION, direction_)
+                && matches(AL_SOURCE_RELATIVE, source_relative_) && matches(AL_LOOPING, looping_);
+        }
+
+    private:
+        void set(ALenum parameter, float& shadow, float value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(value == shadow) return;
+            listener_->ensure_current();
+            AL_HPP_DISPATCHED(dispatch_, al, sourcef, alSourcef)(source_id_, parameter, value);
+            if(al::util::check_al_error(dispatch_, "(setting source property)") == al::no_error) shadow = value;
+        }
+        void set(ALenum parameter, al::vec3& shadow, al::vec3 value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(value == shadow) return;
+            listener_->ensure_current();
+            AL_HPP_DISPATCHED(dispatch_, al, source3f, alSource3f)(source_id_, parameter, value.x, value.y, value.z);
+            if(al::util::check_al_error(dispatch_, "(setting source property)") == al::no_error) shadow = value;
+        }
+        void set(ALenum parameter, ALboolean& shadow, ALboolean value) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(value == shadow) return;
+            listener_->ensure_current();
+            AL_HPP_DISPATCHED(dispatch_, al, sourcei, alSourcei)(source_id_, parameter, value);
+            if(al::util::check_al_error(dispatch_, "(setting source property)") == al::no_error) shadow = value;
+        }
+
+        template<typename T>
+        const T& cached(ALenum parameter, const T& shadow) const AL_HPP_NOEXCEPT {
+#if defined( AL_HPP_SHADOW_STATE_CHECKS )
+            AL_HPP_ASSERT(matches(parameter, shadow));
+#else
+            (void)parameter;
+#endif
+            return shadow;
+        }
+
+        bool matches(ALenum parameter, float shadow) const AL_HPP_NOEXCEPT {
+            ALfloat value = 0.0f;
+            AL_HPP_DISPATCHED(dispatch_, al, getSourcef, alGetSourcef)(source_id_, parameter, &value);
+            return value == shadow;
+        }
+        bool matches(ALenum parameter, al::vec3 shadow) const AL_HPP_NOEXCEPT {
+            al::vec3 value { 0.0f, 0.0f, 0.0f };
+            AL_HPP_DISPATCHED(dispatch_, al, getSource3f, alGetSource3f)(source_id_, parameter, &value.x, &value.y, &value.z);
+            return value == shadow;
+        }
+        bool matches(ALenum parameter, ALboolean shadow) const AL_HPP_NOEXCEPT {
+            ALint value = AL_FALSE;
+            AL_HPP_DISPATCHED(dispatch_, al, getSourcei, alGetSourcei)(source_id_, parameter, &value);
+            return value == shadow;
+        }
+
+        ALint query(ALenum parameter) const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            listener_->ensure_current();
+            ALint value = 0;
+            AL_HPP_DISPATCHED(dispatch_, al, getSourcei, alGetSourcei)(source_id_, parameter, &value);
+            al::util::check_al_error(dispatch_, "(querying source)");
+            return value;
+        }
+        float query_float(ALenum parameter) const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            listener_->ensure_current();
+            ALfloat value = 0.0f;
+            AL_HPP_DISPATCHED(dispatch_, al, getSourcef, alGetSourcef)(source_id_, parameter, &value);
+            al::util::check_al_error(dispatch_, "(querying source)");
+            return value;
+        }
+        template<typename F>
+        void command(F function, const char* message) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            listener_->ensure_current();
+            function(source_id_);
+            al::util::check_al_error(dispatch_, message);
+        }
+
+        const al::listener* listener_;
+        const al::dispatch* dispatch_;
+        ALuint source_id_ = 0;
+
+        // everything starts out with the AL defaults
+        float pitch_ = 1.0f, gain_ = 1.0f;
+        float max_distance_ = std::numeric_limits<float>::max(), rolloff_factor_ = 1.0f, reference_distance_ = 1.0f;
+        float min_gain_ = 0.0f, max_gain_ = 1.0f;
+        float cone_outer_gain_ = 0.0f, cone_inner_angle_ = 360.0f, cone_outer_angle_ = 360.0f;
+        al::vec3 position_ { 0.0f, 0.0f, 0.0f }, velocity_ { 0.0f, 0.0f, 0.0f }, direction_ { 0.0f, 0.0f, 0.0f };
+        ALboolean source_relative_ = AL_FALSE;
+        ALboolean looping_ = AL_FALSE;
+        ALuint current_buffer_id_ = 0; //= AL_BUFFER attribute
+        // state, type, queue counts and offsets change while the source plays, so they aren't shadowed at all
+    };
+
+
+    // pull-style data source for the stream_source. produce() is called on the streaming thread every time a buffer
+    // was processed and has to be refilled, so it should not block for long. Return the number of bytes written
+    // into data (at most max_size, which is a whole number of frames), 0 means the stream has ended. The returned size
+    // has to be whole frames too, AL rejects buffer data that ends in the middle of a frame.
+    class stream_producer {
+    public:
+        virtual ~stream_producer() = default;
+        virtual std::size_t produce(void* data, std::size_t max_size) = 0;
+    };
+
+    // A streaming source with a fixed ring of buffers that get refilled from a stream_producer on a background thread.
+    // All buffer names are generated once in the constructor and only recycled afterwards, the same goes for the staging
+    // memory, so there is no allocation in steady state. The streaming thread binds the listener's context for itself
+    // (see context_scope), so it also works with ALC_EXT_thread_local_context. It never calls getError, which would eat
+    // the application's errors, and tells its own failures apart by what the calls left behind instead; AL still records
+    // them in the context's error state, so the application's next check can see one of them.
+    class stream_source {
+    public:
+        // the listener has to outlive the stream source
+        AL_HPP_NODISCARD stream_source(const al::listener& source_listener, stream_producer& producer, al::format stream_format, ALsizei frequency,
+                                       std::size_t buffer_count = 4, std::size_t buffer_size = 16384) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                     : listener_{&source_listener}, dispatch_{source_listener.dispatch_ptr()},
+                                       producer_(producer), format_(stream_format), frequency_(frequency),
+                                       buffer_ids_(buffer_count), staging_(buffer_size - buffer_size % std::max<std::size_t>(al::frame_bytes(stream_format), 1)) {
+            if(buffer_count < 2) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: a stream source needs at least two buffers!");
+                return;
+            }
+            if(staging_.empty()) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: stream buffer size is smaller than one frame!");
+                return;
+            }
+            listener_->ensure_current();
+            AL_HPP_DISPATCHED(dispatch_, al, genSources, alGenSources)(1, &source_id_);
+            al::util::check_al_error(dispatch_, "(generating stream source)");
+            AL_HPP_DISPATCHED(dispatch_, al, genBuffers, alGenBuffers)(static_cast<ALsizei>(buffer_ids_.size()), buffer_ids_.data());
+            // the destructor doesn't run if this throws, so the source has to go first
+            al::errc code = static_cast<al::errc>(AL_HPP_DISPATCHED(dispatch_, al, getError, alGetError)());
+            if(code != al::errc::no_error) {
+                AL_HPP_DISPATCHED(dispatch_, al, deleteSources, alDeleteSources)(1, &source_id_);
+                source_id_ = 0;
+                AL_HPP_THROW_WHEN_EXCEPTIONS("AL Error: " + al::error_message(code) + "(generating stream buffers)");
+                return;
+            }
+        }
+
+        // the streaming thread holds a pointer to this object, so it can't be copied or moved
+        stream_source(const stream_source&) = delete;
+        stream_source& operator=(const stream_source&) = delete;
+        stream_source(stream_source&&) = delete;
+        stream_source& operator=(stream_source&&) = delete;
+
+        ~stream_source() AL_HPP_NOEXCEPT {
+            stop_thread();
+            listener_->ensure_current();
+            if(source_id_ != 0) {
+                AL_HPP_DISPATCHED(dispatch_, al, sourceStop, alSourceStop)(source_id_);
+                AL_HPP_DISPATCHED(dispatch_, al, sourcei, alSourcei)(source_id_, AL_BUFFER, 0);
+                AL_HPP_DISPATCHED(dispatch_, al, deleteSources, alDeleteSources)(1, &source_id_);
+            }
+            AL_HPP_DISPATCHED(dispatch_, al, deleteBuffers, alDeleteBuffers)(static_cast<ALsizei>(buffer_ids_.size()), buffer_ids_.data());
+        }
+
+        // prefills the ring, starts playback and the streaming thread
+        void play(std::chrono::milliseconds poll_interval = std::chrono::milliseconds(10)) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            // a stream that ran to its end gets restarted from scratch
+            if(finished_) stop_thread();
+            listener_->ensure_current();
+            if(thread_.joinable()) {
+                // under the lock, so the streaming thread doesn't look at the source halfway through
+                std::lock_guard<std::mutex> lock(mutex_);
+                if(paused_.exchange(false)) {
+                    AL_HPP_DISPATCHED(dispatch_, al, sourcePlay, alSourcePlay)(source_id_);
+                    al::util::check_al_error(dispatch_, "(resuming stream source)");
+                }
+                return;
+            }
+
+            // start from an empty queue, old buffers from a previous run are just recycled
+            AL_HPP_DISPATCHED(dispatch_, al, sourceStop, alSourceStop)(source_id_);
+            AL_HPP_DISPATCHED(dispatch_, al, sourcei, alSourcei)(source_id_, AL_BUFFER, 0);
+            al::util::check_al_error(dispatch_, "(resetting stream source)");
+
+            end_of_stream_ = false;
+            paused_ = false;
+            ALsizei queued = 0;
+            for(ALuint buffer_id : buffer_ids_) {
+                if(!fill(buffer_id)) break;
+                AL_HPP_DISPATCHED(dispatch_, al, sourceQueueBuffers, alSourceQueueBuffers)(source_id_, 1, &buffer_id);
+                ++queued;
+            }
+            al::util::check_al_error(dispatch_, "(prefilling stream source)");
+            if(queued == 0) return;
+
+            AL_HPP_DISPATCHED(dispatch_, al, sourcePlay, alSourcePlay)(source_id_);
+            al::util::check_al_error(dispatch_, "(starting stream source)");
+
+            stop_requested_ = false;
+            finished_ = false;
+            poll_interval_ = poll_interval;
+            thread_ = std::thread(&stream_source::run, this);
+        }
+
+        void pause() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            listener_->ensure_current();
+            // under the lock, so the streaming thread can't restart the source right after it was paused
+            std::lock_guard<std::mutex> lock(mutex_);
+            paused_ = true;
+            AL_HPP_DISPATCHED(dispatch_, al, sourcePause, alSourcePause)(source_id_);
+            al::util::check_al_error(dispatch_, "(pausing stream source)");
+        }
+
+        void stop() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            stop_thread();
+            listener_->ensure_current();
+            AL_HPP_DISPATCHED(dispatch_, al, sourceStop, alSourceStop)(source_id_);
+            AL_HPP_DISPATCHED(dispatch_, al, sourcei, alSourcei)(source_id_, AL_BUFFER, 0);
+            al::util::check_al_error(dispatch_, "(stopping stream source)");
+        }
+
+        // true while the streaming thread still has data to queue or the source is still playing the last buffers
+        AL_HPP_NODISCARD bool active() const AL_HPP_NOEXCEPT { return thread_.joinable() && !finished_; }
+
+        // the streaming thread can't throw, so it records the last AL error it ran into; this reports it
+        void check(const char* message = "") const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            al::errc code = last_error_.exchange(al::errc::no_error);
+            if(code != al::errc::no_error) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("AL Error: " + al::error_message(code) + " (in streaming thread)" + message);
+            }
+        }
+
+        // number of times the source ran dry and had to be restarted
+        AL_HPP_NODISCARD std::size_t underruns() const AL_HPP_NOEXCEPT { return underruns_; }
+
+        // returns the name of the source, non-owning
+        AL_HPP_NODISCARD ALuint source_id() const AL_HPP_NOEXCEPT { return source_id_; }
+
     private:
-        ALuint source_id;
-
-        float pitch, gain;
-        float maxDistance, rolloffFactor, referenceDistance;
-        float minGain, maxGain;
-        float coneOuterGain, coneInnerAngle, coneOuterAngle;
-        al::vec3 position, velocity, direction;
-        ALboolean sourceRelative;
-        type current_type;
-        ALboolean looping;
-        std::vector<al::buffer> buffers; //a single buffer or buffersQueued+buffersProcessed buffers
-        ALuint currentBufferId; //= AL_BUFFER attribute
-        state current_state;
-        ALint buffersQueued, buffersProcessed;
-        float secOffset, sampleOffset, byteOffset;
+        bool fill(ALuint buffer_id) AL_HPP_NOEXCEPT {
+            if(end_of_stream_) return false;
+            std::size_t size = producer_.produce(staging_.data(), staging_.size());
+            if(size == 0) {
+                end_of_stream_ = true;
+                return false;
+            }
+            AL_HPP_DISPATCHED(dispatch_, al, bufferData, alBufferData)(buffer_id, format_, staging_.data(), static_cast<ALsizei>(size), frequency_);
+            // a failed upload leaves the old data behind, that buffer stays out of the queue instead of replaying it
+            ALint uploaded = -1;
+            AL_HPP_DISPATCHED(dispatch_, al, getBufferi, alGetBufferi)(buffer_id, AL_SIZE, &uploaded);
+            if(uploaded != static_cast<ALint>(size)) {
+                last_error_ = al::errc::invalid_value;
+                return false;
+            }
+            return true;
+        }
+
+        // getters leave their output alone when they fail, so a value that is still the sentinel means an error
+        ALint query(ALenum parameter) AL_HPP_NOEXCEPT {
+            ALint value = -1;
+            AL_HPP_DISPATCHED(dispatch_, al, getSourcei, alGetSourcei)(source_id_, parameter, &value);
+            if(value == -1) last_error_ = al::errc::invalid_operation;
+            return value;
+        }
+
+        void run() AL_HPP_NOEXCEPT {
+            al::context_scope thread_scope(listener_->context_ptr(), dispatch_);
+            std::unique_lock<std::mutex> lock(mutex_);
+            while(!stop_requested_) {
+                // the state has to be read before the processed count: if the source stops in between, every buffer it
+                // played is already counted as processed, so nothing stale is left queued for the restart below
+                const ALint state = query(AL_SOURCE_STATE);
+
+                for(ALint processed = query(AL_BUFFERS_PROCESSED); processed > 0; --processed) {
+                    ALuint buffer_id = 0;
+                    AL_HPP_DISPATCHED(dispatch_, al, sourceUnqueueBuffers, alSourceUnqueueBuffers)(source_id_, 1, &buffer_id);
+                    if(buffer_id == 0) {
+                        last_error_ = al::errc::invalid_operation;
+                        break;
+                    }
+                    // at the end of the stream the name just stays unqueued until the next play()
+                    if(fill(buffer_id))
+                        AL_HPP_DISPATCHED(dispatch_, al, sourceQueueBuffers, alSourceQueueBuffers)(source_id_, 1, &buffer_id);
+                }
+
+                const ALint queued = query(AL_BUFFERS_QUEUED);
+                if(state == AL_STOPPED) {
+                    if(queued == 0 && end_of_stream_) break;
+                    // the source ran out of data before we could refill it, so restart with the fresh buffers queued now
+                    if(queued > 0 && !paused_) {
+                        ++underruns_;
+                        AL_HPP_DISPATCHED(dispatch_, al, sourcePlay, alSourcePlay)(source_id_);
+                    }
+                }
+
+                wake_.wait_for(lock, poll_interval_);
+            }
+            finished_ = true;
+        }
+
+        void stop_thread() AL_HPP_NOEXCEPT {
+            if(!thread_.joinable()) return;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_requested_ = true;
+            }
+            wake_.notify_one();
+            thread_.join();
+        }
+
+        const al::listener* listener_;
+        const al::dispatch* dispatch_;
+        stream_producer& producer_;
+        al::format format_;
+        ALsizei frequency_;
+
+        ALuint source_id_ = 0;
+        std::vector<ALuint> buffer_ids_;
+        std::vector<unsigned char> staging_;
+
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::chrono::milliseconds poll_interval_ { 10 };
+        bool stop_requested_ = false;
+        bool end_of_stream_ = false;
+        std::atomic<bool> paused_ { false };
+        std::atomic<bool> finished_ { false };
+        std::atomic<std::size_t> underruns_ { 0 };
+        mutable std::atomic<al::errc> last_error_ { al::errc::no_error };
     };
 
 
+
+    // Maps a large number of logical voices onto a fixed set of real sources that are generated once.
+    // Every update() ranks the playing voices by priority times audibility, the best ones get a real source, the others
+    // become virtual: they keep their playback position advancing with the elapsed time and get a source back
+    // (starting at that position) once they rank high enough again. Newly started voices get their source on the next update().
+    // Audibility is estimated with the inverse clamped distance model, which is the AL default.
+    class voice_pool {
+    public:
+        struct handle {
+            std::uint32_t index = 0;
+            std::uint32_t generation = 0;
+        };
+
+        struct voice_desc {
+            ALuint buffer = 0;
+            float priority = 1.0f;
+            float gain = 1.0f;
+            float pitch = 1.0f;
+            al::vec3 position {0.0f, 0.0f, 0.0f};
+            bool looping = false;
+            bool relative = false;
+            float reference_distance = 1.0f;
+            float rolloff_factor = 1.0f;
+        };
+
+        AL_HPP_NODISCARD explicit voice_pool(std::size_t real_voices, float audibility_threshold = 0.001f) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                           : source_ids_(real_voices), audibility_threshold_(audibility_threshold) {
+            al::genSources(static_cast<ALsizei>(source_ids_.size()), source_ids_.data());
+            al::check_error("(generating voice pool sources)");
+            length_query_ = al::util::extension_present("AL_SOFT_buffer_length_query", nullptr);
+            free_sources_ = source_ids_;
+            ranking_.reserve(real_voices * 4);
+        }
+
+        voice_pool(const voice_pool&) = delete;
+        voice_pool& operator=(const voice_pool&) = delete;
+
+        ~voice_pool() AL_HPP_NOEXCEPT {
+            if(source_ids_.empty()) return;
+            al::sourceStopv(static_cast<ALsizei>(source_ids_.size()), source_ids_.data());
+            al::deleteSources(static_cast<ALsizei>(source_ids_.size()), source_ids_.data());
+        }
+
+        AL_HPP_NODISCARD handle play(const voice_desc& desc) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            ALint size = 0, bits = 0, channels = 0, frequency = 0;
+            al::getBufferi(desc.buffer, AL_SIZE, &size);
+            al::getBufferi(desc.buffer, AL_BITS, &bits);
+            al::getBufferi(desc.buffer, AL_CHANNELS, &channels);
+            al::getBufferi(desc.buffer, AL_FREQUENCY, &frequency);
+            al::check_error("(querying voice buffer)");
+
+            std::uint32_t index;
+            if(!free_voices_.empty()) {
+                index = free_voices_.back();
+                free_voices_.pop_back();
+            } else {
+                index = static_cast<std::uint32_t>(voices_.size());
+                voices_.emplace_back();
+            }
+            voice& v = voices_[index];
+            v.desc = desc;
+            v.active = true;
+            v.dirty = false;
+            v.source_id = 0;
+            v.offset = 0.0f;
+            v.duration = duration(desc.buffer, size, bits, channels, frequency);
+            return handle { index, v.generation };
+        }
+
+        void stop(handle h) AL_HPP_NOEXCEPT {
+            voice* v = get(h);
+            if(v == nullptr) return;
+            release(*v);
+            retire(h.index);
+        }
+
+        void set_position(handle h, al::vec3 position) AL_HPP_NOEXCEPT {
+            voice* v = get(h);
+            if(v == nullptr) return;
+            v->desc.position = position;
+            v->dirty = true;
+        }
+        void set_gain(handle h, float gain) AL_HPP_NOEXCEPT {
+            voice* v = get(h);
+            if(v == nullptr) return;
+            v->desc.gain = gain;
+            v->dirty = true;
+        }
+        void set_priority(handle h, float priority) AL_HPP_NOEXCEPT {
+            voice* v = get(h);
+            if(v != nullptr) v->desc.priority = priority;
+        }
+
+        // a stale handle (finished or stopped voice) is neither playing nor virtual
+        AL_HPP_NODISCARD bool playing(handle h) const AL_HPP_NOEXCEPT { return get(h) != nullptr; }
+        AL_HPP_NODISCARD bool is_virtual(handle h) const AL_HPP_NOEXCEPT {
+            const voice* v = get(h);
+            return v != nullptr && v->source_id == 0;
+        }
+
+        AL_HPP_NODISCARD std::size_t real_voices() const AL_HPP_NOEXCEPT { return source_ids_.size() - free_sources_.size(); }
+        AL_HPP_NODISCARD std::size_t active_voices() const AL_HPP_NOEXCEPT { return voices_.size() - free_voices_.size(); }
+
+        // call once per frame, with the time since the last call and the listener position
+        void update(float elapsed_seconds, al::vec3 listener_position) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            al::batch update_batch;
+
+            ranking_.clear();
+            for(std::uint32_t index = 0; index < voices_.size(); ++index) {
+                voice& v = voices_[index];
+                if(!v.active) continue;
+
+                if(!advance(v, elapsed_seconds)) {
+                    release(v);
+                    retire(index);
+                    continue;
+                }
+
+                float score = v.desc.priority * audibility(v.desc, listener_position);
+                if(score >= audibility_threshold_)
+                    ranking_.push_back(ranked { score, index });
+                else
+                    release(v);
+            }
+
+            // only the best source_ids_.size() voices are real, everything past that becomes virtual
+            std::size_t real_count = std::min(ranking_.size(), source_ids_.size());
+            std::partial_sort(ranking_.begin(), ranking_.begin() + real_count, ranking_.end(),
+                              [](const ranked& a, const ranked& b) { return a.score > b.score; });
+            for(std::size_t rank = real_count; rank < ranking_.size(); ++rank)
+                release(voices_[ranking_[rank].index]);
+
+            for(std::size_t rank = 0; rank < real_count; ++rank) {
+                voice& v = voices_[ranking_[rank].index];
+                if(v.source_id == 0)
+                    acquire(v);
+                else if(v.dirty)
+                    push_properties(v);
+            }
+            al::check_error("(updating voice pool)");
+        }
+
+    private:
+        struct voice {
+            voice_desc desc;
+            ALuint source_id = 0;
+            float offset = 0.0f, duration = 0.0f;
+            std::uint32_t generation = 0;
+            bool active = false, dirty = false;
+        };
+        struct ranked {
+            float score;
+            std::uint32_t index;
+        };
+
+        voice* get(handle h) AL_HPP_NOEXCEPT {
+            if(h.index >= voices_.size()) return nullptr;
+            voice& v = voices_[h.index];
+            return (v.active && v.generation == h.generation) ? &v : nullptr;
+        }
+        const voice* get(handle h) const AL_HPP_NOEXCEPT {
+            return const_cast<voice_pool*>(this)->get(h);
+        }
+
+        static float audibility(const voice_desc& desc, al::vec3 listener_position) AL_HPP_NOEXCEPT {
+            al::vec3 p = desc.position;
+            if(!desc.relative) {
+                p.x -= listener_position.x;
+                p.y -= listener_position.y;
+                p.z -= listener_position.z;
+            }
+            float distance = std::sqrt(p.x*p.x + p.y*p.y + p.z*p.z);
+            distance = std::max(distance, desc.reference_distance);
+            float attenuation = desc.reference_distance / (desc.reference_distance + desc.rolloff_factor * (distance - desc.reference_distance));
+            return desc.gain * attenuation;
+        }
+
+        // Length of the buffer in seconds. Counting bytes only works for PCM, IMA4 and MSADPCM blocks carry headers, so the
+        // implementation is asked through AL_SOFT_buffer_length_query when it has it. Compressed buffers of unknown length
+        // get 0, so their voices finish once they turn virtual instead of playing on at a made up offset.
+        float duration(ALuint buffer_id, ALint size, ALint bits, ALint channels, ALint frequency) const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(frequency <= 0) return 0.0f;
+            if(length_query_) {
+                ALint length = 0;
+                al::getBufferi(buffer_id, AL_SAMPLE_LENGTH_SOFT, &length);
+                al::check_error("(querying voice buffer length)");
+                return static_cast<float>(length) / static_cast<float>(frequency);
+            }
+            if(bits < 8 || channels <= 0) return 0.0f;
+            return static_cast<float>(size) * 8.0f / static_cast<float>(bits * channels) / static_cast<float>(frequency);
+        }
+
+        // advances the playback position, returns false if the voice has finished
+        bool advance(voice& v, float elapsed_seconds) AL_HPP_NOEXCEPT {
+            if(v.source_id != 0) {
+                ALint state = AL_STOPPED;
+                al::getSourcei(v.source_id, AL_SOURCE_STATE, &state);
+                return state != AL_STOPPED;
+            }
+            v.offset += elapsed_seconds * v.desc.pitch;
+            if(v.offset < v.duration) return true;
+            if(!v.desc.looping || v.duration <= 0.0f) return false;
+            v.offset = std::fmod(v.offset, v.duration);
+            return true;
+        }
+
+        void push_properties(voice& v) AL_HPP_NOEXCEPT {
+            al::sourcef(v.source_id, AL_GAIN, v.desc.gain);
+            al::source3f(v.source_id, AL_POSITION, v.desc.position.x, v.desc.position.y, v.desc.position.z);
+            v.dirty = false;
+        }
+
+        void acquire(voice& v) AL_HPP_NOEXCEPT {
+            v.source_id = free_sources_.back();
+            free_sources_.pop_back();
+            al::sourcei(v.source_id, AL_BUFFER, static_cast<ALint>(v.desc.buffer));
+            al::sourcef(v.source_id, AL_PITCH, v.desc.pitch);
+            al::sourcei(v.source_id, AL_LOOPING, v.desc.looping ? AL_TRUE : AL_FALSE);
+            al::sourcei(v.source_id, AL_SOURCE_RELATIVE, v.desc.relative ? AL_TRUE : AL_FALSE);
+            al::sourcef(v.source_id, AL_REFERENCE_DISTANCE, v.desc.reference_distance);
+            al::sourcef(v.source_id, AL_ROLLOFF_FACTOR, v.desc.rolloff_factor);
+            push_properties(v);
+            al::sourcef(v.source_id, AL_SEC_OFFSET, v.offset);
+            al::sourcePlay(v.source_id);
+        }
+
+        // makes a voice virtual (or just gives back its source when it's finished)
+        void release(voice& v) AL_HPP_NOEXCEPT {
+            if(v.source_id == 0) return;
+            al::getSourcef(v.source_id, AL_SEC_OFFSET, &v.offset);
+            al::sourceStop(v.source_id);
+            al::sourcei(v.source_id, AL_BUFFER, 0);
+            free_sources_.push_back(v.source_id);
+            v.source_id = 0;
+        }
+
+        void retire(std::uint32_t index) AL_HPP_NOEXCEPT {
+            voice& v = voices_[index];
+            v.active = false;
+            ++v.generation;
+            free_voices_.push_back(index);
+        }
+
+        std::vector<ALuint> source_ids_;
+        std::vector<ALuint> free_sources_;
+        std::vector<voice> voices_;
+        std::vector<std::uint32_t> free_voices_;
+        std::vector<ranked> ranking_;
+        float audibility_threshold_;
+        bool length_query_ = false;
+    };
+
+
+    // Shares uploaded buffers between everyone loading the same asset. Buffers are keyed either by an asset id or by their
+    // content and handed out as reference counted handles. Content keys are a hash and a fingerprint, not the whole data, so
+    // two different payloads can in principle alias and share a buffer; use asset ids where that must never happen. Buffers that nobody holds anymore stay cached until the
+    // bytes uploaded to the device exceed the budget, then the least recently used of them are deleted.
+    // Not thread safe, and the cache has to outlive all of its handles.
+    class buffer_cache {
+        struct entry;
+    public:
+        using key_type = std::string;
+        // bytes from either end of the content that go into its key next to the hash
+        static AL_HPP_CONST_OR_CONSTEXPR std::size_t fingerprint_bytes = 16;
+
+        class handle {
+        public:
+            handle() = default;
+            handle(const handle& other) AL_HPP_NOEXCEPT : cache_{other.cache_}, entry_{other.entry_} {
+                if(entry_ != nullptr) ++entry_->references;
+            }
+            handle(handle&& other) AL_HPP_NOEXCEPT : cache_{other.cache_}, entry_{other.entry_} {
+                other.entry_ = nullptr;
+            }
+            handle& operator=(handle other) AL_HPP_NOEXCEPT {
+                std::swap(cache_, other.cache_);
+                std::swap(entry_, other.entry_);
+                return *this;
+            }
+            ~handle() AL_HPP_NOEXCEPT {
+                if(entry_ != nullptr && --entry_->references == 0)
+                    cache_->enforce_budget();
+            }
+
+            // returns the buffer name, non-owning
+            AL_HPP_NODISCARD ALuint buffer_id() const AL_HPP_NOEXCEPT { return entry_ != nullptr ? entry_->buffer_id : 0; }
+            AL_HPP_NODISCARD explicit operator bool() const AL_HPP_NOEXCEPT { return entry_ != nullptr; }
+
+        private:
+            friend class buffer_cache;
+            handle(buffer_cache* cache, entry* cache_entry) AL_HPP_NOEXCEPT : cache_{cache}, entry_{cache_entry} {
+                ++entry_->references;
+            }
+
+            buffer_cache* cache_ = nullptr;
+            entry* entry_ = nullptr;
+        };
+
+        // the buffers are made through the device's dispatch, so its context has to be current
+        AL_HPP_NODISCARD buffer_cache(const al::device& cache_device, std::size_t budget_bytes) AL_HPP_NOEXCEPT
+                                    : device_ptr_(cache_device.device_ptr()), dispatch_(cache_device.dispatch_ptr()), budget_(budget_bytes) {}
+
+        buffer_cache(const buffer_cache&) = delete;
+        buffer_cache& operator=(const buffer_cache&) = delete;
+
+        ~buffer_cache() AL_HPP_NOEXCEPT {
+            for(auto& cached : entries_)
+                AL_HPP_DISPATCHED(dispatch_, al, deleteBuffers, alDeleteBuffers)(1, &cached.second.buffer_id);
+        }
+
+        // asset ids and contents get a different first byte, so an id can never match some content
+        AL_HPP_NODISCARD static key_type asset_key(const std::string& asset_id) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            return 'a' + asset_id;
+        }
+        // content is keyed by a 64 bit FNV-1a hash of the bytes together with their size, format and frequency, so the key
+        // stays small and no copy of the data is kept. The first and last bytes go into the key as well, so two payloads
+        // only alias if they also agree there. The same bytes in another format or frequency are a different buffer
+        AL_HPP_NODISCARD static key_type content_key(const void* data, ALsizei size, al::format data_format, ALsizei frequency) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            std::uint64_t hash = 14695981039346656037ULL;
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for(ALsizei i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+            ALint description[3] = { static_cast<ALint>(data_format), frequency, size };
+            const std::size_t edge = static_cast<std::size_t>(size) < fingerprint_bytes ? static_cast<std::size_t>(size) : fingerprint_bytes;
+            key_type key;
+            key.reserve(1 + sizeof(hash) + sizeof(description) + 2 * edge);
+            key += 'c';
+            key.append(reinterpret_cast<const char*>(&hash), sizeof(hash));
+            key.append(reinterpret_cast<const char*>(description), sizeof(description));
+            key.append(reinterpret_cast<const char*>(bytes), edge);
+            key.append(reinterpret_cast<const char*>(bytes) + size - edge, edge);
+            return key;
+        }
+
+        // returns the cached buffer, or an empty handle if it isn't cached
+        AL_HPP_NODISCARD handle find(const key_type& key) AL_HPP_NOEXCEPT {
+            auto found = entries_.find(key);
+            if(found == entries_.end()) return handle();
+            touch(found->second);
+            ++hits_;
+            return handle(this, &found->second);
+        }
+
+        // returns the cached buffer, uploads the data only if the asset isn't cached yet
+        AL_HPP_NODISCARD handle get(const std::string& asset_id, const void* data, ALsizei size, al::format data_format, ALsizei frequency) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            return get_keyed(asset_key(asset_id), data, size, data_format, frequency);
+        }
+        AL_HPP_NODISCARD handle get(const void* data, ALsizei size, al::format data_format, ALsizei frequency) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            return get_keyed(content_key(data, size, data_format, frequency), data, size, data_format, frequency);
+        }
+
+        void set_budget(std::size_t budget_bytes) AL_HPP_NOEXCEPT {
+            budget_ = budget_bytes;
+            enforce_budget();
+        }
+
+        // deletes every buffer that isn't referenced anymore, regardless of the budget
+        void trim() AL_HPP_NOEXCEPT { evict_until(0); }
+
+        AL_HPP_NODISCARD ALCdevice*  device_ptr()     const AL_HPP_NOEXCEPT { return device_ptr_; }
+        AL_HPP_NODISCARD const al::dispatch* dispatch_ptr() const AL_HPP_NOEXCEPT { return dispatch_; }
+        AL_HPP_NODISCARD std::size_t budget()         const AL_HPP_NOEXCEPT { return budget_; }
+        AL_HPP_NODISCARD std::size_t bytes_uploaded() const AL_HPP_NOEXCEPT { return bytes_uploaded_; }
+        AL_HPP_NODISCARD std::size_t buffer_count()   const AL_HPP_NOEXCEPT { return entries_.size(); }
+        AL_HPP_NODISCARD std::size_t hits()           const AL_HPP_NOEXCEPT { return hits_; }
+        AL_HPP_NODISCARD std::size_t misses()         const AL_HPP_NOEXCEPT { return misses_; }
+        AL_HPP_NODISCARD std::size_t evictions()      const AL_HPP_NOEXCEPT { return evictions_; }
+
+    private:
+        struct entry {
+            ALuint buffer_id = 0;
+            std::size_t size = 0;
+            std::size_t references = 0;
+            // points at the key inside entries_, which stays put while the entry exists
+            std::list<const key_type*>::iterator recency;
+        };
+
+        AL_HPP_NODISCARD handle get_keyed(key_type&& key, const void* data, ALsizei size, al::format data_format, ALsizei frequency) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            handle cached = find(key);
+            if(cached) return cached;
+
+            ALuint buffer_id = 0;
+            AL_HPP_DISPATCHED(dispatch_, al, genBuffers, alGenBuffers)(1, &buffer_id);
+            al::util::check_al_error(dispatch_, "(generating cached buffer)");
+            AL_HPP_DISPATCHED(dispatch_, al, bufferData, alBufferData)(buffer_id, data_format, data, size, frequency);
+            // the buffer has to be gone before the error is thrown
+            al::errc code = static_cast<al::errc>(AL_HPP_DISPATCHED(dispatch_, al, getError, alGetError)());
+            if(code != al::errc::no_error) {
+                AL_HPP_DISPATCHED(dispatch_, al, deleteBuffers, alDeleteBuffers)(1, &buffer_id);
+                AL_HPP_THROW_WHEN_EXCEPTIONS("AL Error: " + al::error_message(code) + "(uploading cached buffer)");
+                return handle();
+            }
+            ++misses_;
+
+            auto inserted = entries_.emplace(std::move(key), entry()).first;
+            entry& new_entry = inserted->second;
+            new_entry.buffer_id = buffer_id;
+            new_entry.size = static_cast<std::size_t>(size);
+            new_entry.recency = recency_.insert(recency_.begin(), &inserted->first);
+            bytes_uploaded_ += new_entry.size;
+
+            handle uploaded(this, &new_entry);
+            enforce_budget();
+            return uploaded;
+        }
+
+        void touch(entry& cached) AL_HPP_NOEXCEPT {
+            recency_.splice(recency_.begin(), recency_, cached.recency);
+        }
+
+        void enforce_budget() AL_HPP_NOEXCEPT { evict_until(budget_); }
+
+        // walks from the least recently used end, referenced buffers are skipped
+        void evict_until(std::size_t target_bytes) AL_HPP_NOEXCEPT {
+            auto it = recency_.end();
+            while(bytes_uploaded_ > target_bytes && it != recency_.begin()) {
+                --it;
+                auto found = entries_.find(**it);
+                if(found->second.references > 0) continue;
+
+                AL_HPP_DISPATCHED(dispatch_, al, deleteBuffers, alDeleteBuffers)(1, &found->second.buffer_id);
+                bytes_uploaded_ -= found->second.size;
+                ++evictions_;
+                it = recency_.erase(it);
+                entries_.erase(found);
+            }
+        }
+
+        ALCdevice* device_ptr_;
+        const al::dispatch* dispatch_;
+        std::size_t budget_;
+        std::size_t bytes_uploaded_ = 0;
+        std::size_t hits_ = 0, misses_ = 0, evictions_ = 0;
+        std::unordered_map<key_type, entry> entries_;
+        // front is the most recently used
+        std::list<const key_type*> recency_;
+    };
+
+
+    namespace util {
+        // read-only mapping of a whole file, unmapped on destruction
+        class file_mapping {
+        public:
+            file_mapping() = default;
+
+            AL_HPP_NODISCARD explicit file_mapping(const AL_HPP_PATH& path) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+#if defined( _WIN32 )
+                // GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL
+#  if 17 <= AL_HPP_CPP_VERSION
+                // filesystem paths are wide on windows, so non-ASCII names open too
+                HANDLE file = CreateFileW(path.c_str(), 0x80000000UL, 0x00000001UL, nullptr, 3UL, 0x80UL, nullptr);
+#  else
+                HANDLE file = CreateFileA(path.c_str(), 0x80000000UL, 0x00000001UL, nullptr, 3UL, 0x80UL, nullptr);
+#  endif
+                if(file == reinterpret_cast<HANDLE>(-1)) {
+                    AL_HPP_THROW_WHEN_EXCEPTIONS("Error: could not open file for mapping!");
+                    return;
+                }
+                unsigned long size_high = 0;
+                unsigned long size_low = GetFileSize(file, &size_high);
+                size_ = (static_cast<std::size_t>(size_high) << 32) | size_low;
+                // PAGE_READONLY
+                HANDLE mapping = size_ > 0 ? CreateFileMappingA(file, nullptr, 0x02UL, 0, 0, nullptr) : nullptr;
+                CloseHandle(file);
+                if(mapping == nullptr) {
+                    size_ = 0;
+                    AL_HPP_THROW_WHEN_EXCEPTIONS("Error: could not map file!");
+                    return;
+                }
+                // FILE_MAP_READ; the view keeps the mapping object alive
+                data_ = MapViewOfFile(mapping, 0x0004UL, 0, 0, 0);
+                CloseHandle(mapping);
+#elif defined( AL_HPP_HAS_FILE_MAPPING )
+                int file = open(path.c_str(), O_RDONLY);
+                if(file < 0) {
+                    AL_HPP_THROW_WHEN_EXCEPTIONS("Error: could not open file for mapping!");
+                    return;
+                }
+                struct stat file_info;
+                if(fstat(file, &file_info) == 0 && file_info.st_size > 0) {
+                    size_ = static_cast<std::size_t>(file_info.st_size);
+                    void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+                    data_ = mapped != MAP_FAILED ? mapped : nullptr;
+                }
+                close(file);
+#endif
+                if(data_ == nullptr) {
+                    size_ = 0;
+                    AL_HPP_THROW_WHEN_EXCEPTIONS("Error: could not map file!");
+                    return;
+                }
+            }
+
+            file_mapping(const file_mapping&) = delete;
+            file_mapping& operator=(const file_mapping&) = delete;
+
+            file_mapping(file_mapping&& old_mapping) AL_HPP_NOEXCEPT : data_{old_mapping.data_}, size_{old_mapping.size_} {
+                old_mapping.data_ = nullptr;
+                old_mapping.size_ = 0;
+            }
+            file_mapping& operator=(file_mapping&& old_mapping) AL_HPP_NOEXCEPT {
+                if(this != &old_mapping) {
+                    unmap();
+                    data_ = old_mapping.data_;
+                    size_ = old_mapping.size_;
+                    old_mapping.data_ = nullptr;
+                    old_mapping.size_ = 0;
+                }
+                return *this;
+            }
+
+            ~file_mapping() AL_HPP_NOEXCEPT { unmap(); }
+
+            void unmap() AL_HPP_NOEXCEPT {
+                if(data_ == nullptr) return;
+#if defined( _WIN32 )
+                UnmapViewOfFile(data_);
+#elif defined( AL_HPP_HAS_FILE_MAPPING )
+                munmap(data_, size_);
+#endif
+                data_ = nullptr;
+                size_ = 0;
+            }
+
+            AL_HPP_NODISCARD const unsigned char* data() const AL_HPP_NOEXCEPT { return static_cast<const unsigned char*>(data_); }
+            AL_HPP_NODISCARD std::size_t          size() const AL_HPP_NOEXCEPT { return size_; }
+
+        private:
+            void* data_ = nullptr;
+            std::size_t size_ = 0;
+        };
+
+        AL_HPP_NODISCARD std::uint16_t read_le16(const unsigned char* bytes) AL_HPP_NOEXCEPT {
+            return static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8));
+        }
+        AL_HPP_NODISCARD std::uint32_t read_le32(const unsigned char* bytes) AL_HPP_NOEXCEPT {
+            return static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8)
+                 | (static_cast<std::uint32_t>(bytes[2]) << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+        }
+    }
+
+    // A buffer backed by a memory mapped WAV or raw PCM file. With AL_EXT_STATIC_BUFFER the driver plays straight from the
+    // mapping (so it stays mapped as long as the buffer exists), otherwise the data is uploaded once with bufferData and
+    // the file is unmapped right away.
+    class mapped_buffer {
+    public:
+        // WAV file, the header is parsed in place
+        AL_HPP_NODISCARD explicit mapped_buffer(const AL_HPP_PATH& path) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS : mapping_(path) {
+            if(!parse_wav()) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: unsupported or broken WAV file!");
+                return;
+            }
+            upload();
+        }
+
+        // headerless PCM, starting at offset bytes into the file
+        AL_HPP_NODISCARD mapped_buffer(const AL_HPP_PATH& path, al::format data_format, ALsizei frequency, std::size_t offset = 0) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                     : mapping_(path), format_(data_format), frequency_(frequency) {
+            if(offset > mapping_.size()) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: offset lies past the end of the PCM file!");
+                return;
+            }
+            data_ = mapping_.data() + offset;
+            size_ = mapping_.size() - offset;
+            // AL rejects data that ends in the middle of a frame, so a trailing partial frame is left out
+            if(al::frame_bytes(format_) != 0)
+                size_ -= size_ % al::frame_bytes(format_);
+            upload();
+        }
+
+        mapped_buffer(const mapped_buffer&) = delete;
+        mapped_buffer& operator=(const mapped_buffer&) = delete;
+
+        ~mapped_buffer() AL_HPP_NOEXCEPT {
+            // the buffer has to go before the memory it plays from
+            if(buffer_id_ != 0)
+                al::deleteBuffers(1, &buffer_id_);
+        }
+
+        // returns the buffer name, non-owning
+        AL_HPP_NODISCARD ALuint     buffer_id()   const AL_HPP_NOEXCEPT { return buffer_id_; }
+        AL_HPP_NODISCARD al::format data_format() const AL_HPP_NOEXCEPT { return format_; }
+        AL_HPP_NODISCARD ALsizei    frequency()   const AL_HPP_NOEXCEPT { return frequency_; }
+        AL_HPP_NODISCARD std::size_t size()       const AL_HPP_NOEXCEPT { return size_; }
+        // true if the driver reads from the mapping instead of its own copy
+        AL_HPP_NODISCARD bool       is_static()   const AL_HPP_NOEXCEPT { return static_; }
+
+    private:
+        bool parse_wav() AL_HPP_NOEXCEPT {
+            const unsigned char* bytes = mapping_.data();
+            const std::size_t file_size = mapping_.size();
+            if(file_size < 12 || std::memcmp(bytes, "RIFF", 4) != 0 || std::memcmp(bytes + 8, "WAVE", 4) != 0)
+                return false;
+
+            bool have_format = false;
+            std::size_t position = 12;
+            while(position + 8 <= file_size) {
+                const unsigned char* chunk = bytes + position;
+                std::size_t chunk_size = util::read_le32(chunk + 4);
+                std::size_t body = position + 8;
+                if(chunk_size > file_size - body) chunk_size = file_size - body;
+
+                if(std::memcmp(chunk, "fmt ", 4) == 0 && chunk_size >= 16) {
+                    std::uint16_t encoding = util::read_le16(chunk + 8);
+                    // WAVE_FORMAT_EXTENSIBLE stores the actual encoding in its sub format GUID
+                    if(encoding == 0xFFFE && chunk_size >= 26)
+                        encoding = util::read_le16(chunk + 8 + 24);
+                    std::uint16_t channels = util::read_le16(chunk + 8 + 2);
+                    std::uint16_t bits = util::read_le16(chunk + 8 + 14);
+                    frequency_ = static_cast<ALsizei>(util::read_le32(chunk + 8 + 4));
+
+                    // WAVE_FORMAT_PCM
+                    if(encoding != 1) return false;
+                    if(channels == 1 && bits == 8)       format_ = al::format::mono8;
+                    else if(channels == 1 && bits == 16) format_ = al::format::mono16;
+                    else if(channels == 2 && bits == 8)  format_ = al::format::stereo8;
+                    else if(channels == 2 && bits == 16) format_ = al::format::stereo16;
+                    else return false;
+                    have_format = true;
+                } else if(std::memcmp(chunk, "data", 4) == 0) {
+                    data_ = bytes + body;
+                    size_ = chunk_size;
+                    return have_format;
+                }
+                // chunks are padded to even sizes
+                position = body + chunk_size + (chunk_size & 1);
+            }
+            return false;
+        }
+
+        void upload() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            // AL takes the size as ALsizei, a bigger file would wrap or be cut off
+            if(size_ > static_cast<std::size_t>(std::numeric_limits<ALsizei>::max())) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: mapped file is too large for a single buffer!");
+                return;
+            }
+            al::genBuffers(1, &buffer_id_);
+            al::check_error("(generating mapped buffer)");
+            const bool use_static = al::bufferDataStatic != nullptr;
+            if(use_static) {
+                // the driver only reads from the memory, the non-const pointer is just the extension's signature
+                al::bufferDataStatic(buffer_id_, format_, const_cast<unsigned char*>(data_), static_cast<ALsizei>(size_), frequency_);
+            } else {
+                al::bufferData(buffer_id_, format_, data_, static_cast<ALsizei>(size_), frequency_);
+            }
+            // the destructor doesn't run if the constructor throws, so the buffer has to go first
+            al::errc code = static_cast<al::errc>(al::getError());
+            if(code != al::errc::no_error) {
+                al::deleteBuffers(1, &buffer_id_);
+                buffer_id_ = 0;
+                AL_HPP_THROW_WHEN_EXCEPTIONS("AL Error: " + al::error_message(code) + "(uploading mapped buffer)");
+                return;
+            }
+            static_ = use_static;
+
+            if(!static_) {
+                mapping_.unmap();
+                data_ = nullptr;
+            }
+        }
+
+        util::file_mapping mapping_;
+        const unsigned char* data_ = nullptr;
+        std::size_t size_ = 0;
+        al::format format_ = al::format::mono16;
+        ALsizei frequency_ = 0;
+        ALuint buffer_id_ = 0;
+        bool static_ = false;
+    };
+
+
+    namespace util {
+        // bytes per sample frame, at least 1 so it can be divided by
+        AL_HPP_NODISCARD AL_HPP_INLINE std::size_t frame_size(al::format sample_format) AL_HPP_NOEXCEPT {
+            return std::max<std::size_t>(al::frame_bytes(sample_format), 1);
+        }
+
+        // Wait-free single producer, single consumer byte ring. One thread writes, one thread reads, neither locks nor allocates.
+        // The capacity is rounded up to a power of two so the indices can just run and wrap with a mask.
+        class spsc_ring {
+        public:
+            AL_HPP_NODISCARD explicit spsc_ring(std::size_t min_capacity) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+                std::size_t capacity = 1;
+                while(capacity < min_capacity) capacity <<= 1;
+                storage_.resize(capacity);
+                mask_ = capacity - 1;
+            }
+
+            spsc_ring(const spsc_ring&) = delete;
+            spsc_ring& operator=(const spsc_ring&) = delete;
+
+            // producer side, returns the number of bytes that fit
+            std::size_t write(const void* data, std::size_t size) AL_HPP_NOEXCEPT {
+                const std::size_t tail = tail_.load(std::memory_order_relaxed);
+                const std::size_t head = head_.load(std::memory_order_acquire);
+                size = std::min(size, capacity() - (tail - head));
+                copy_in(tail, static_cast<const unsigned char*>(data), size);
+                tail_.store(tail + size, std::memory_order_release);
+                return size;
+            }
+
+            // consumer side, returns the number of bytes read
+            std::size_t read(void* data, std::size_t size) AL_HPP_NOEXCEPT {
+                const std::size_t head = head_.load(std::memory_order_relaxed);
+                const std::size_t tail = tail_.load(std::memory_order_acquire);
+                size = std::min(size, tail - head);
+                copy_out(head, static_cast<unsigned char*>(data), size);
+                head_.store(head + size, std::memory_order_release);
+                return size;
+            }
+
+            // contiguous part of the ring, for filling or reading it in place instead of copying
+            struct region {
+                unsigned char* data;
+                std::size_t size;
+            };
+
+            // producer side, the free space up to the end of the storage; write into it, then commit_write() what was written
+            AL_HPP_NODISCARD region write_region() AL_HPP_NOEXCEPT {
+                const std::size_t tail = tail_.load(std::memory_order_relaxed);
+                const std::size_t head = head_.load(std::memory_order_acquire);
+                const std::size_t start = tail & mask_;
+                return region { storage_.data() + start, std::min(capacity() - (tail - head), capacity() - start) };
+            }
+            void commit_write(std::size_t size) AL_HPP_NOEXCEPT {
+                tail_.store(tail_.load(std::memory_order_relaxed) + size, std::memory_order_release);
+            }
+
+            // consumer side, the readable bytes up to the end of the storage; read them, then commit_read() what was used
+            AL_HPP_NODISCARD region read_region() AL_HPP_NOEXCEPT {
+                const std::size_t head = head_.load(std::memory_order_relaxed);
+                const std::size_t tail = tail_.load(std::memory_order_acquire);
+                const std::size_t start = head & mask_;
+                return region { storage_.data() + start, std::min(tail - head, capacity() - start) };
+            }
+            void commit_read(std::size_t size) AL_HPP_NOEXCEPT {
+                head_.store(head_.load(std::memory_order_relaxed) + size, std::memory_order_release);
+            }
+
+            // bytes ready to read, exact for the consumer, a lower bound for everyone else
+            AL_HPP_NODISCARD std::size_t available() const AL_HPP_NOEXCEPT {
+                return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+            }
+            // bytes that can be written, exact for the producer, a lower bound for everyone else
+            AL_HPP_NODISCARD std::size_t free_space() const AL_HPP_NOEXCEPT { return capacity() - available(); }
+            AL_HPP_NODISCARD std::size_t capacity()   const AL_HPP_NOEXCEPT { return mask_ + 1; }
+
+        private:
+            void copy_in(std::size_t position, const unsigned char* data, std::size_t size) AL_HPP_NOEXCEPT {
+                const std::size_t start = position & mask_;
+                const std::size_t first = std::min(size, capacity() - start);
+                std::memcpy(storage_.data() + start, data, first);
+                std::memcpy(storage_.data(), data + first, size - first);
+            }
+            void copy_out(std::size_t position, unsigned char* data, std::size_t size) const AL_HPP_NOEXCEPT {
+                const std::size_t start = position & mask_;
+                const std::size_t first = std::min(size, capacity() - start);
+                std::memcpy(data, storage_.data() + start, first);
+                std::memcpy(data + first, storage_.data(), size - first);
+            }
+
+            std::vector<unsigned char> storage_;
+            std::size_t mask_ = 0;
+            // on separate cache lines, so producer and consumer don't bounce the same line back and forth
+            alignas(64) std::atomic<std::size_t> head_ { 0 };
+            alignas(64) std::atomic<std::size_t> tail_ { 0 };
+        };
+    }
+
+    // Source that plays from an AL_SOFT_callback_buffer fed by a spsc_ring. A producer thread (decoder, network, synthesizer)
+    // calls write(), the mixer pulls from the ring in its callback without locking or allocating. If the ring runs dry the
+    // callback pads with silence and counts an underrun, so the source keeps playing instead of stopping.
+    // Needs al::update() to have loaded the extension and a current context.
+    class callback_stream {
+    public:
+        AL_HPP_NODISCARD callback_stream(al::format stream_format, ALsizei frequency, std::size_t ring_size = 65536) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                       : ring_(ring_size), frame_size_(al::util::frame_size(stream_format)),
+                                         silence_(silence_byte(al::describe(stream_format).encoding)) {
+            if(al::bufferCallbackSOFT == nullptr) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: callback streams need the AL_SOFT_callback_buffer extension!");
+                return;
+            }
+            al::genBuffers(1, &buffer_id_);
+            if(!check_construction("(generating callback buffer)")) return;
+            al::bufferCallbackSOFT(buffer_id_, stream_format, frequency, &callback_stream::callback, this);
+            if(!check_construction("(registering buffer callback)")) return;
+            al::genSources(1, &source_id_);
+            if(!check_construction("(generating callback source)")) return;
+            al::sourcei(source_id_, AL_BUFFER, static_cast<ALint>(buffer_id_));
+            check_construction("(attaching callback buffer)");
+        }
+
+        // the mixer holds a pointer to this object
+        callback_stream(const callback_stream&) = delete;
+        callback_stream& operator=(const callback_stream&) = delete;
+        callback_stream(callback_stream&&) = delete;
+        callback_stream& operator=(callback_stream&&) = delete;
+
+        ~callback_stream() AL_HPP_NOEXCEPT { release(); }
+
+        void play() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            al::sourcePlay(source_id_);
+            al::check_error("(playing callback stream)");
+        }
+        void stop() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            al::sourceStop(source_id_);
+            al::check_error("(stopping callback stream)");
+        }
+
+        // producer side; writes whole frames only and returns how many bytes fit into the ring. A trailing partial frame is
+        // dropped, frames that didn't fit count as an overrun
+        std::size_t write(const void* data, std::size_t size) AL_HPP_NOEXCEPT {
+            const std::size_t frames_size = size - size % frame_size_;
+            std::size_t space = ring_.free_space();
+            space -= space % frame_size_;
+            std::size_t written = ring_.write(data, std::min(frames_size, space));
+            if(written < frames_size)
+                overruns_.fetch_add(1, std::memory_order_relaxed);
+            return written;
+        }
+
+        AL_HPP_NODISCARD std::size_t free_space() const AL_HPP_NOEXCEPT { return ring_.free_space(); }
+        AL_HPP_NODISCARD std::size_t buffered()   const AL_HPP_NOEXCEPT { return ring_.available(); }
+        AL_HPP_NODISCARD std::size_t underruns()  const AL_HPP_NOEXCEPT { return underruns_.load(std::memory_order_relaxed); }
+        AL_HPP_NODISCARD std::size_t overruns()   const AL_HPP_NOEXCEPT { return overruns_.load(std::memory_order_relaxed); }
+
+        // returns the name of the source, non-owning
+        AL_HPP_NODISCARD ALuint source_id() const AL_HPP_NOEXCEPT { return source_id_; }
+
+    private:
+        // the destructor doesn't run if the constructor throws, so whatever was generated so far has to go first
+        bool check_construction(const char* message) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            al::errc code = static_cast<al::errc>(al::getError());
+            if(code == al::errc::no_error) return true;
+            release();
+            AL_HPP_THROW_WHEN_EXCEPTIONS("AL Error: " + al::error_message(code) + message);
+            return false;
+        }
+
+        void release() AL_HPP_NOEXCEPT {
+            if(source_id_ != 0) {
+                al::sourceStop(source_id_);
+                al::deleteSources(1, &source_id_);
+                source_id_ = 0;
+            }
+            if(buffer_id_ != 0) {
+                al::deleteBuffers(1, &buffer_id_);
+                buffer_id_ = 0;
+            }
+        }
+
+        // unsigned 8 bit samples are silent at 128, mu-law at 0xFF (0x00 would be full scale negative), the signed ones at 0
+        static AL_HPP_CONSTEXPR int silence_byte(al::sample_encoding encoding) AL_HPP_NOEXCEPT {
+            return encoding == al::sample_encoding::uint8 ? 0x80 : encoding == al::sample_encoding::mulaw ? 0xFF : 0;
+        }
+
+        // runs on the mixer thread
+        static ALsizei AL_APIENTRY callback(ALvoid* user_pointer, ALvoid* sample_data, ALsizei byte_count) AL_HPP_NOEXCEPT {
+            callback_stream* stream = static_cast<callback_stream*>(user_pointer);
+            std::size_t wanted = static_cast<std::size_t>(byte_count);
+            std::size_t ready = stream->ring_.available();
+            ready -= ready % stream->frame_size_;
+
+            std::size_t read = stream->ring_.read(sample_data, std::min(wanted, ready));
+            if(read < wanted) {
+                std::memset(static_cast<unsigned char*>(sample_data) + read, stream->silence_, wanted - read);
+                stream->underruns_.fetch_add(1, std::memory_order_relaxed);
+            }
+            // returning less than requested would end the stream
+            return byte_count;
+        }
+
+        util::spsc_ring ring_;
+        std::size_t frame_size_;
+        int silence_;
+        ALuint buffer_id_ = 0;
+        ALuint source_id_ = 0;
+        std::atomic<std::size_t> underruns_ { 0 };
+        std::atomic<std::size_t> overruns_ { 0 };
+    };
+
+
+    // Device that doesn't output anywhere, but renders on request into memory (ALC_SOFT_loopback). Since nothing waits
+    // for a sound card, it renders as fast as the CPU allows, which is what offline rendering and headless tests want.
+    // The render format has to be passed on to the context, so create the listener with attributes():
+    //     al::loopback_device loopback { {48000, al::loopback_device::channels::stereo, al::loopback_device::sample_type::int16} };
+    //     al::listener offline_listener { loopback, loopback.attributes().data() };
+    class loopback_device : public device {
+    public:
+        enum class channels {
+            mono = ALC_MONO_SOFT,
+            stereo = ALC_STEREO_SOFT,
+            quad = ALC_QUAD_SOFT,
+            surround51 = ALC_5POINT1_SOFT,
+            surround61 = ALC_6POINT1_SOFT,
+            surround71 = ALC_7POINT1_SOFT
+        };
+
+        enum class sample_type {
+            int8 = ALC_BYTE_SOFT,
+            uint8 = ALC_UNSIGNED_BYTE_SOFT,
+            int16 = ALC_SHORT_SOFT,
+            uint16 = ALC_UNSIGNED_SHORT_SOFT,
+            int32 = ALC_INT_SOFT,
+            uint32 = ALC_UNSIGNED_INT_SOFT,
+            float32 = ALC_FLOAT_SOFT
+        };
+
+        struct render_format {
+            ALCint frequency = 48000;
+            channels layout = channels::stereo;
+            sample_type type = sample_type::float32;
+        };
+
+        AL_HPP_NODISCARD static std::size_t channel_count(channels layout) AL_HPP_NOEXCEPT {
+            switch(layout) {
+                case channels::mono: return 1;
+                case channels::stereo: return 2;
+                case channels::quad: return 4;
+                case channels::surround51: return 6;
+                case channels::surround61: return 7;
+                case channels::surround71: return 8;
+            }
+            return 0;
+        }
+        AL_HPP_NODISCARD static std::size_t sample_size(sample_type type) AL_HPP_NOEXCEPT {
+            switch(type) {
+                case sample_type::int8: case sample_type::uint8: return 1;
+                case sample_type::int16: case sample_type::uint16: return 2;
+                case sample_type::int32: case sample_type::uint32: case sample_type::float32: return 4;
+            }
+            return 0;
+        }
+
+        // 48kHz float stereo
+        AL_HPP_NODISCARD loopback_device() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS : loopback_device(render_format()) {}
+
+        AL_HPP_NODISCARD explicit loopback_device(render_format format, const char* device_name = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                                : loopback_device(nullptr, format, device_name) {}
+
+        // loopback device of the implementation of loopback_dispatch, e.g. to run offline renders in isolation from the playback device
+        AL_HPP_NODISCARD loopback_device(al::dispatch& loopback_dispatch, render_format format, const char* device_name = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                        : loopback_device(&loopback_dispatch, format, device_name) {}
+
+    private:
+        loopback_device(al::dispatch* loopback_dispatch, render_format format, const char* device_name) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                       : device(open_loopback(loopback_dispatch, device_name), device_name, loopback_dispatch), format_(format) {
+            if(device_ptr() == nullptr) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: could not open ALC loopback device!");
+                return;
+            }
+            update_info();
+            if(!supports(format_)) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: render format not supported by the loopback device!");
+                return;
+            }
+        }
+
+    public:
+        AL_HPP_NODISCARD bool supports(const render_format& format) const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            ALCboolean supported = AL_HPP_DISPATCHED(dispatch_ptr(), alc, isRenderFormatSupportedSOFT, alcIsRenderFormatSupportedSOFT)(device_ptr(), format.frequency,
+                                                                    static_cast<ALCenum>(format.layout), static_cast<ALCenum>(format.type));
+            check("(querying loopback render format)");
+            return supported == ALC_TRUE;
+        }
+
+        // zero-terminated context attributes selecting the render format
+        AL_HPP_NODISCARD std::vector<ALCint> attributes() const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            return std::vector<ALCint> {
+                ALC_FREQUENCY, format_.frequency,
+                ALC_FORMAT_CHANNELS_SOFT, static_cast<ALCint>(format_.layout),
+                ALC_FORMAT_TYPE_SOFT, static_cast<ALCint>(format_.type),
+                0
+            };
+        }
+
+        AL_HPP_NODISCARD render_format format()     const AL_HPP_NOEXCEPT { return format_; }
+        AL_HPP_NODISCARD std::size_t   frame_size() const AL_HPP_NOEXCEPT { return channel_count(format_.layout) * sample_size(format_.type); }
+
+        // renders frame_count frames into data, which has to hold frame_count * frame_size() bytes
+        void render(void* data, std::size_t frame_count) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            AL_HPP_DISPATCHED(dispatch_ptr(), alc, renderSamplesSOFT, alcRenderSamplesSOFT)(device_ptr(), data, static_cast<ALCsizei>(frame_count));
+            check("(rendering loopback samples)");
+        }
+
+        // renders as many whole frames as fit into samples, the sample type has to match the render format. Element types
+        // that no render format uses don't compile
+        template<typename T>
+        void render(std::vector<T>& samples) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(sample_type_of(static_cast<const T*>(nullptr)) != format_.type) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: sample type doesn't match the loopback render format!");
+                return;
+            }
+            render(samples.data(), samples.size() / channel_count(format_.layout));
+        }
+
+        // renders frame_count frames into a WAV file, block_frames at a time; WAV can only hold uint8, int16, int32 and float32
+        void render_to_wav(const AL_HPP_PATH& path, std::size_t frame_count, std::size_t block_frames = 16384) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(format_.type == sample_type::int8 || format_.type == sample_type::uint16 || format_.type == sample_type::uint32) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: sample type can't be stored in a WAV file!");
+                return;
+            }
+            if(block_frames == 0) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: WAV rendering needs at least one frame per block!");
+                return;
+            }
+            const std::uint32_t channel_number = static_cast<std::uint32_t>(channel_count(format_.layout));
+            const std::uint32_t bits = static_cast<std::uint32_t>(sample_size(format_.type) * 8);
+            const std::uint32_t block_align = channel_number * bits / 8;
+            // the RIFF size field is 32 bit and counts the 36 header bytes after it too
+            if(frame_count > (std::numeric_limits<std::uint32_t>::max() - 36) / block_align) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: WAV files can't hold more than 4 GiB!");
+                return;
+            }
+            const std::uint32_t data_size = static_cast<std::uint32_t>(frame_count * block_align);
+            // WAVE_FORMAT_IEEE_FLOAT or WAVE_FORMAT_PCM
+            const std::uint32_t encoding = format_.type == sample_type::float32 ? 3 : 1;
+
+            std::ofstream file(path, std::ios::binary);
+            if(!file) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: could not open WAV file for writing!");
+                return;
+            }
+
+            unsigned char header[44];
+            std::memcpy(header, "RIFF", 4);
+            write_le32(header + 4, 36 + data_size);
+            std::memcpy(header + 8, "WAVEfmt ", 8);
+            write_le32(header + 16, 16);
+            write_le16(header + 20, encoding);
+            write_le16(header + 22, channel_number);
+            write_le32(header + 24, static_cast<std::uint32_t>(format_.frequency));
+            write_le32(header + 28, static_cast<std::uint32_t>(format_.frequency) * block_align);
+            write_le16(header + 32, block_align);
+            write_le16(header + 34, bits);
+            std::memcpy(header + 36, "data", 4);
+            write_le32(header + 40, data_size);
+            file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+            std::vector<char> block(block_frames * block_align);
+            while(frame_count > 0) {
+                std::size_t frames = std::min(frame_count, block_frames);
+                render(block.data(), frames);
+                file.write(block.data(), static_cast<std::streamsize>(frames * block_align));
+                frame_count -= frames;
+            }
+            if(!file) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: could not write WAV file!");
+            }
+        }
+
+    private:
+        static gsl::owner<ALCdevice*> open_loopback(al::dispatch* loopback_dispatch, const char* device_name) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            // the extension functions are only loaded by al::update(), which needs a device, so fetch them here if necessary
+            bool loaded = AL_HPP_DISPATCHED(loopback_dispatch, alc, loopbackOpenDeviceSOFT, alcLoopbackOpenDeviceSOFT) != nullptr
+                       || (loopback_dispatch != nullptr ? loopback_dispatch->load_extension("ALC_SOFT_loopback") : al::load_extension("ALC_SOFT_loopback"));
+            if(!loaded) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: loopback devices need the ALC_SOFT_loopback extension!");
+                return nullptr;
+            }
+            gsl::owner<ALCdevice*> device_ptr = AL_HPP_DISPATCHED(loopback_dispatch, alc, loopbackOpenDeviceSOFT, alcLoopbackOpenDeviceSOFT)(device_name);
+            al::util::check_alc_error(loopback_dispatch, nullptr, "(opening ALC loopback device)");
+            return device_ptr;
+        }
+
+        // picks the render format sample type of render()'s element type by overload
+        static AL_HPP_CONSTEXPR sample_type sample_type_of(const std::int8_t*)   AL_HPP_NOEXCEPT { return sample_type::int8; }
+        static AL_HPP_CONSTEXPR sample_type sample_type_of(const std::uint8_t*)  AL_HPP_NOEXCEPT { return sample_type::uint8; }
+        static AL_HPP_CONSTEXPR sample_type sample_type_of(const std::int16_t*)  AL_HPP_NOEXCEPT { return sample_type::int16; }
+        static AL_HPP_CONSTEXPR sample_type sample_type_of(const std::uint16_t*) AL_HPP_NOEXCEPT { return sample_type::uint16; }
+        static AL_HPP_CONSTEXPR sample_type sample_type_of(const std::int32_t*)  AL_HPP_NOEXCEPT { return sample_type::int32; }
+        static AL_HPP_CONSTEXPR sample_type sample_type_of(const std::uint32_t*) AL_HPP_NOEXCEPT { return sample_type::uint32; }
+        static AL_HPP_CONSTEXPR sample_type sample_type_of(const float*)         AL_HPP_NOEXCEPT { return sample_type::float32; }
+
+        static void write_le16(unsigned char* bytes, std::uint32_t value) AL_HPP_NOEXCEPT {
+            bytes[0] = static_cast<unsigned char>(value);
+            bytes[1] = static_cast<unsigned char>(value >> 8);
+        }
+        static void write_le32(unsigned char* bytes, std::uint32_t value) AL_HPP_NOEXCEPT {
+            write_le16(bytes, value);
+            write_le16(bytes + 2, value >> 16);
+        }
+
+        render_format format_;
+    };
+
+
+    namespace util {
+        // Bounded multi producer, single consumer queue (Dmitry Vyukov's sequence number design). Producers never block
+        // and never allocate: a push onto a full queue fails instead. Capacity is rounded up to a power of two.
+        template<typename T>
+        class mpsc_queue {
+        public:
+            AL_HPP_NODISCARD explicit mpsc_queue(std::size_t min_capacity) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+                std::size_t capacity = 1;
+                while(capacity < min_capacity) capacity <<= 1;
+                cells_ = std::unique_ptr<cell[]>(new cell[capacity]);
+                for(std::size_t i = 0; i < capacity; ++i)
+                    cells_[i].sequence.store(i, std::memory_order_relaxed);
+                mask_ = capacity - 1;
+            }
+
+            mpsc_queue(const mpsc_queue&) = delete;
+            mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+            // any thread
+            bool try_push(const T& value) AL_HPP_NOEXCEPT {
+                std::size_t position = tail_.load(std::memory_order_relaxed);
+                for(;;) {
+                    cell& current = cells_[position & mask_];
+                    const std::size_t sequence = current.sequence.load(std::memory_order_acquire);
+                    const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+                    if(difference == 0) {
+                        if(tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                            current.value = value;
+                            current.sequence.store(position + 1, std::memory_order_release);
+                            return true;
+                        }
+                    } else if(difference < 0) {
+                        return false;
+                    } else {
+                        position = tail_.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            // consumer thread only
+            bool try_pop(T& value) AL_HPP_NOEXCEPT {
+                cell& current = cells_[head_ & mask_];
+                if(current.sequence.load(std::memory_order_acquire) != head_ + 1) return false;
+                value = current.value;
+                current.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+                ++head_;
+                return true;
+            }
+
+            AL_HPP_NODISCARD std::size_t capacity() const AL_HPP_NOEXCEPT { return mask_ + 1; }
+
+        private:
+            struct cell {
+                std::atomic<std::size_t> sequence;
+                T value;
+            };
+
+            std::unique_ptr<cell[]> cells_;
+            std::size_t mask_ = 0;
+            alignas(64) std::atomic<std::size_t> tail_ { 0 };
+            alignas(64) std::size_t head_ = 0;
+        };
+    }
+
+    // one AL_SOFT_events notification, copied out of the callback
+    struct event {
+        enum class type {
+            buffer_completed = AL_EVENT_TYPE_BUFFER_COMPLETED_SOFT,
+            source_state_changed = AL_EVENT_TYPE_SOURCE_STATE_CHANGED_SOFT,
+            disconnected = AL_EVENT_TYPE_DISCONNECTED_SOFT,
+#if defined( AL_EVENT_TYPE_DEPRECATED_SOFT )
+            // only in older OpenAL Soft versions, the final extension dropped it
+            deprecated = AL_EVENT_TYPE_DEPRECATED_SOFT,
+#endif
+        };
+
+        type event_type;
+        // the source for buffer_completed and source_state_changed
+        ALuint object;
+        // the number of completed buffers for buffer_completed, the new AL_SOURCE_STATE for source_state_changed
+        ALuint param;
+        // truncated, the callback mustn't allocate
+        char message[96];
+    };
+
+    // Collects AL_SOFT_events notifications of the current context in a lock-free queue, so instead of polling AL_SOURCE_STATE and
+    // AL_BUFFERS_PROCESSED of every source every frame, the application only looks at what actually happened. The callback runs on
+    // the implementation's event thread and only copies into the queue; events that don't fit are counted in dropped().
+    // drain() is for a single consumer thread, which also runs the per-source subscriptions. There's only one event callback per
+    // context, so only one event_queue per listener. The listener has to outlive the queue. Needs al::update() to have loaded the extension.
+    class event_queue {
+    public:
+        AL_HPP_NODISCARD explicit event_queue(const al::listener& events_listener, std::size_t capacity = 1024) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                             : queue_(capacity), listener_(&events_listener), dispatch_(events_listener.dispatch_ptr()) {
+            events_listener.ensure_current();
+            LPALEVENTCALLBACKSOFT event_callback = AL_HPP_DISPATCHED(dispatch_, al, eventCallbackSOFT, alEventCallbackSOFT);
+            if(event_callback == nullptr || AL_HPP_DISPATCHED(dispatch_, al, eventControlSOFT, alEventControlSOFT) == nullptr) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: event queues need the AL_SOFT_events extension!");
+                return;
+            }
+            event_callback(&event_queue::callback, this);
+            al::util::check_al_error(dispatch_, "(setting event callback)");
+            // the destructor doesn't run if this throws, so the callback mustn't stay installed with a dangling pointer
+            al::errc code = control(AL_TRUE);
+            if(code != al::errc::no_error) {
+                event_callback(nullptr, nullptr);
+                AL_HPP_THROW_WHEN_EXCEPTIONS("AL Error: " + al::error_message(code) + "(enabling events)");
+                return;
+            }
+            registered_ = true;
+        }
+
+        // the queue is registered by address
+        event_queue(const event_queue&) = delete;
+        event_queue& operator=(const event_queue&) = delete;
+
+        // the callback has to come off the listener's context even if another one is current here, so that one is bound for
+        // the cleanup and the previous binding restored afterwards
+        ~event_queue() AL_HPP_NOEXCEPT {
+            if(!registered_) return;
+            ALCcontext* previous_ptr = al::util::current_context(dispatch_);
+            const bool rebound = previous_ptr != listener_->context_ptr() && al::util::bind_context(listener_->context_ptr(), dispatch_);
+            (void)control(AL_FALSE);
+            AL_HPP_DISPATCHED(dispatch_, al, eventCallbackSOFT, alEventCallbackSOFT)(nullptr, nullptr);
+            if(rebound) al::util::bind_context(previous_ptr, dispatch_);
+        }
+
+        // pops a single event, false if there was none
+        bool poll(al::event& next_event) AL_HPP_NOEXCEPT { return queue_.try_pop(next_event); }
+
+        // hands every queued event to the subscription of its source (if any) and then to handler, returns the number of events
+        template<typename F>
+        std::size_t drain(F&& handler) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            std::size_t count = 0;
+            al::event next_event;
+            while(queue_.try_pop(next_event)) {
+                ++count;
+                if(next_event.event_type != al::event::type::disconnected) {
+                    auto subscription = subscriptions_.find(next_event.object);
+                    if(subscription != subscriptions_.end()) subscription->second(next_event);
+                }
+                handler(next_event);
+            }
+            return count;
+        }
+        std::size_t drain() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            return drain([](const al::event&) {});
+        }
+
+        // called from drain() for events of source_id; replaces an earlier subscription of the same source
+        void subscribe(ALuint source_id, std::function<void(const al::event&)> handler) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            subscriptions_[source_id] = std::move(handler);
+        }
+        void unsubscribe(ALuint source_id) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            subscriptions_.erase(source_id);
+        }
+
+        // events lost because the queue was full
+        AL_HPP_NODISCARD std::uint64_t dropped() const AL_HPP_NOEXCEPT { return dropped_.load(std::memory_order_relaxed); }
+
+    private:
+        // returns the error instead of throwing, the destructor calls this too
+        al::errc control(ALboolean enable) AL_HPP_NOEXCEPT {
+            static const ALenum types[] = {
+                AL_EVENT_TYPE_BUFFER_COMPLETED_SOFT,
+                AL_EVENT_TYPE_SOURCE_STATE_CHANGED_SOFT,
+                AL_EVENT_TYPE_DISCONNECTED_SOFT,
+#if defined( AL_EVENT_TYPE_DEPRECATED_SOFT )
+                AL_EVENT_TYPE_DEPRECATED_SOFT,
+#endif
+            };
+            AL_HPP_DISPATCHED(dispatch_, al, eventControlSOFT, alEventControlSOFT)(static_cast<ALsizei>(sizeof(types) / sizeof(types[0])), types, enable);
+            return static_cast<al::errc>(AL_HPP_DISPATCHED(dispatch_, al, getError, alGetError)());
+        }
+
+        static void AL_APIENTRY callback(ALenum event_type, ALuint object, ALuint param, ALsizei length, const ALchar* message, void* user_param) AL_HPP_NOEXCEPT {
+            event_queue* self = static_cast<event_queue*>(user_param);
+            al::event next_event;
+            next_event.event_type = static_cast<al::event::type>(event_type);
+            next_event.object = object;
+            next_event.param = param;
+            std::size_t message_length = message != nullptr && length > 0 ? std::min(static_cast<std::size_t>(length), sizeof(next_event.message) - 1) : 0;
+            if(message_length > 0) std::memcpy(next_event.message, message, message_length);
+            next_event.message[message_length] = '\0';
+            if(!self->queue_.try_push(next_event))
+                self->dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        al::util::mpsc_queue<al::event> queue_;
+        const al::listener* listener_;
+        const al::dispatch* dispatch_;
+        std::unordered_map<ALuint, std::function<void(const al::event&)>> subscriptions_;
+        std::atomic<std::uint64_t> dropped_ { 0 };
+        bool registered_ = false;
+    };
+
+
+    // Starts sources at an exact time on the device clock (ALC_SOFT_device_clock), e.g. for music sync. Times are on the output
+    // timeline, output_time() being the device clock minus the device latency, i.e. what's being heard right now. A source started
+    // now is mixed at clock() and heard one latency later, so play_at() moves each time back by the latency it queries then.
+    // Pending starts sit in a timer wheel on the mix timeline; update() has to be called regularly (every tick or every frame) and starts everything
+    // that's due with one sourcePlayv per group inside a batch, so the sources of a group start in the same mix. Since a start can
+    // only be noticed after its time, each source of a late group is started with an AL_SEC_OFFSET of the lateness, which keeps it
+    // on the timeline. Needs al::update() to have loaded the extension and the device's context to be current.
+    class scheduler {
+    public:
+        using clock_time = std::chrono::nanoseconds;
+        using ticket = std::uint64_t;
+
+        AL_HPP_NODISCARD explicit scheduler(const al::device& clock_device, clock_time tick = std::chrono::milliseconds(1), std::size_t slot_count = 512)
+                                           AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                          : device_ptr_(clock_device.device_ptr()), dispatch_(clock_device.dispatch_ptr()),
+                                            tick_(std::max(tick.count(), static_cast<clock_time::rep>(1))), slots_(std::max(slot_count, static_cast<std::size_t>(1))) {
+            if(AL_HPP_DISPATCHED(dispatch_, alc, getInteger64vSOFT, alcGetInteger64vSOFT) == nullptr) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: scheduling needs the ALC_SOFT_device_clock extension!");
+                return;
+            }
+            processed_tick_ = clock().count() / tick_ - 1;
+        }
+
+        scheduler(const scheduler&) = delete;
+        scheduler& operator=(const scheduler&) = delete;
+
+        // the device clock, counting the samples mixed so far
+        AL_HPP_NODISCARD clock_time clock() const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS { return query(ALC_DEVICE_CLOCK_SOFT); }
+        AL_HPP_NODISCARD clock_time latency() const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS { return query(ALC_DEVICE_LATENCY_SOFT); }
+        // the time that is being heard right now, queried atomically: the clock is how far the mix got, and the latency is
+        // how long the mixed samples take to come out of the speakers
+        AL_HPP_NODISCARD clock_time output_time() const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            ALCint64SOFT values[2] = {0, 0};
+            AL_HPP_DISPATCHED(dispatch_, alc, getInteger64vSOFT, alcGetInteger64vSOFT)(device_ptr_, ALC_DEVICE_CLOCK_LATENCY_SOFT, 2, values);
+            al::util::check_alc_error(dispatch_, device_ptr_, "(querying device clock)");
+            return clock_time(values[0] - values[1]);
+        }
+
+        // starts all sources together so they are heard at time; they should be stopped or initial. Returns a ticket for cancel()
+        ticket play_at(const ALuint* source_ids, std::size_t count, clock_time time) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            const clock_time mix_time = time - latency();
+            group new_group { next_ticket_++, mix_time, std::vector<ALuint>(source_ids, source_ids + count) };
+            // anything that's already due goes into the next slot that update() looks at
+            const clock_time::rep due_tick = std::max(mix_time.count() / tick_, processed_tick_ + 1);
+            slots_[static_cast<std::size_t>(due_tick) % slots_.size()].push_back(std::move(new_group));
+            ++pending_;
+            return next_ticket_ - 1;
+        }
+        ticket play_at(const std::vector<ALuint>& source_ids, clock_time time) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            return play_at(source_ids.data(), source_ids.size(), time);
+        }
+        ticket play_at(ALuint source_id, clock_time time) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            return play_at(&source_id, 1, time);
+        }
+
+        // false if the group was already started or cancelled
+        bool cancel(ticket group_ticket) AL_HPP_NOEXCEPT {
+            for(std::vector<group>& slot : slots_) {
+                if(remove(slot, group_ticket)) return true;
+            }
+            return remove(due_, group_ticket);
+        }
+
+        // starts everything that's due, returns the number of groups started
+        std::size_t update() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            const clock_time now = clock();
+            const clock_time::rep current_tick = now.count() / tick_;
+            // groups left over from a pass whose start failed are still in due_ and get started late now
+            if(current_tick <= processed_tick_ && due_.empty()) return 0;
+
+            // after more than a revolution every slot gets looked at once
+            const clock_time::rep first_tick = std::max(processed_tick_ + 1, current_tick - static_cast<clock_time::rep>(slots_.size()) + 1);
+            for(clock_time::rep tick_index = first_tick; tick_index <= current_tick; ++tick_index) {
+                std::vector<group>& slot = slots_[static_cast<std::size_t>(tick_index) % slots_.size()];
+                for(std::size_t i = 0; i < slot.size();) {
+                    if(slot[i].due > now) { ++i; continue; }
+                    due_.push_back(std::move(slot[i]));
+                    slot[i] = std::move(slot.back());
+                    slot.pop_back();
+                }
+            }
+            // the current slot can still hold entries due later in this tick, so it's looked at again next time
+            processed_tick_ = std::max(processed_tick_, current_tick - 1);
+            if(due_.empty()) return 0;
+
+            al::batch start_batch(nullptr, dispatch_);
+            std::size_t started = 0;
+            // each group leaves due_ before its start is checked, so a failing check drops only that group
+            while(!due_.empty()) {
+                const group due_group = std::move(due_.back());
+                due_.pop_back();
+                --pending_;
+                const float lateness = std::chrono::duration<float>(now - due_group.due).count();
+                if(lateness > 0.0f) {
+                    for(ALuint source_id : due_group.sources)
+                        AL_HPP_DISPATCHED(dispatch_, al, sourcef, alSourcef)(source_id, AL_SEC_OFFSET, lateness);
+                }
+                AL_HPP_DISPATCHED(dispatch_, al, sourcePlayv, alSourcePlayv)(static_cast<ALsizei>(due_group.sources.size()), due_group.sources.data());
+                al::util::check_al_error(dispatch_, "(starting scheduled sources)");
+                ++started;
+            }
+            return started;
+        }
+
+        AL_HPP_NODISCARD std::size_t pending() const AL_HPP_NOEXCEPT { return pending_; }
+
+        // playback position of a source in seconds and the device clock it belongs to, both from the same mix (AL_SOFT_source_latency)
+        AL_HPP_NODISCARD std::pair<double, clock_time> position(ALuint source_id) const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            ALdouble values[2] = {0.0, 0.0};
+            LPALGETSOURCEDVSOFT get_source_double = AL_HPP_DISPATCHED(dispatch_, al, getSourcedvSOFT, alGetSourcedvSOFT);
+            if(get_source_double == nullptr) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: source positions need the AL_SOFT_source_latency extension!");
+                return std::make_pair(0.0, clock_time(0));
+            }
+            get_source_double(source_id, AL_SEC_OFFSET_CLOCK_SOFT, values);
+            al::util::check_al_error(dispatch_, "(querying source position)");
+            return std::make_pair(values[0], std::chrono::duration_cast<clock_time>(std::chrono::duration<double>(values[1])));
+        }
+
+    private:
+        struct group {
+            ticket id;
+            clock_time due;
+            std::vector<ALuint> sources;
+        };
+
+        bool remove(std::vector<group>& groups, ticket group_ticket) AL_HPP_NOEXCEPT {
+            for(std::size_t i = 0; i < groups.size(); ++i) {
+                if(groups[i].id != group_ticket) continue;
+                groups[i] = std::move(groups.back());
+                groups.pop_back();
+                --pending_;
+                return true;
+            }
+            return false;
+        }
+
+        clock_time query(ALCenum parameter) const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            ALCint64SOFT value = 0;
+            AL_HPP_DISPATCHED(dispatch_, alc, getInteger64vSOFT, alcGetInteger64vSOFT)(device_ptr_, parameter, 1, &value);
+            al::util::check_alc_error(dispatch_, device_ptr_, "(querying device clock)");
+            return clock_time(value);
+        }
+
+        ALCdevice* device_ptr_;
+        const al::dispatch* dispatch_;
+        clock_time::rep tick_;
+        std::vector<std::vector<group>> slots_;
+        std::vector<group> due_;
+        clock_time::rep processed_tick_ = -1;
+        std::size_t pending_ = 0;
+        ticket next_ticket_ = 1;
+    };
+
+
+    // Capture (recording) device. A reader thread polls ALC_CAPTURE_SAMPLES and moves everything the implementation has
+    // captured straight into a preallocated lock-free ring, so the implementation's own buffer doesn't overflow when the
+    // consumer is late, and reading doesn't allocate. The consumer reads whole frames with read(), or in place with
+    // read_region()/consume(). If the ring itself is full, the samples wait in the implementation's buffer, and what
+    // doesn't fit there anymore is lost; overruns() counts the polls that found the ring full.
+    class capture_device {
+    public:
+        // frequency, format and buffer_frames (the size of the implementation's buffer) are passed on to alcCaptureOpenDevice,
+        // ring_frames is the size of the ring, rounded up so the ring holds a power of two bytes
+        AL_HPP_NODISCARD explicit capture_device(const char* device_name = nullptr, ALCuint frequency = 44100, al::format capture_format = al::format::mono16,
+                                                 ALCsizei buffer_frames = 4096, std::size_t ring_frames = 65536) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                               : capture_device(nullptr, device_name, frequency, capture_format, buffer_frames, ring_frames) {}
+
+        AL_HPP_NODISCARD capture_device(const al::dispatch& capture_dispatch, const char* device_name = nullptr, ALCuint frequency = 44100,
+                                        al::format capture_format = al::format::mono16, ALCsizei buffer_frames = 4096, std::size_t ring_frames = 65536)
+                                        AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                      : capture_device(&capture_dispatch, device_name, frequency, capture_format, buffer_frames, ring_frames) {}
+
+        // the reader thread holds a pointer to this object, so it can't be copied or moved
+        capture_device(const capture_device&) = delete;
+        capture_device& operator=(const capture_device&) = delete;
+        capture_device(capture_device&&) = delete;
+        capture_device& operator=(capture_device&&) = delete;
+
+        ~capture_device() AL_HPP_NOEXCEPT {
+            stop_thread();
+            if(device_ptr_ != nullptr) {
+                AL_HPP_DISPATCHED(dispatch_, alc, captureStop, alcCaptureStop)(device_ptr_);
+                AL_HPP_DISPATCHED(dispatch_, alc, captureCloseDevice, alcCaptureCloseDevice)(device_ptr_);
+            }
+        }
+
+        // starts capturing and the reader thread
+        void start(std::chrono::milliseconds poll_interval = std::chrono::milliseconds(5)) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(thread_.joinable()) return;
+            AL_HPP_DISPATCHED(dispatch_, alc, captureStart, alcCaptureStart)(device_ptr_);
+            check("(starting capture)");
+            stop_requested_ = false;
+            poll_interval_ = poll_interval;
+            thread_ = std::thread(&capture_device::run, this);
+        }
+
+        // stops capturing; what was captured so far stays readable
+        void stop() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            stop_thread();
+            AL_HPP_DISPATCHED(dispatch_, alc, captureStop, alcCaptureStop)(device_ptr_);
+            check("(stopping capture)");
+        }
+
+        // copies at most frame_count frames into data, returns the number of frames read
+        std::size_t read(void* data, std::size_t frame_count) AL_HPP_NOEXCEPT {
+            return ring_.read(data, std::min(frame_count, available()) * frame_size_) / frame_size_;
+        }
+#if defined( AL_HPP_SUPPORT_SPAN )
+        // C++20 with a library that has std::span (checked through <version>, see the top of the file)
+        // reads as many whole frames as fit into samples, the sample type has to match the format
+        template<typename T>
+        std::size_t read(std::span<T> samples) AL_HPP_NOEXCEPT {
+            static_assert(!std::is_const<T>::value, "captured frames are written into samples");
+            AL_HPP_ASSERT(frame_size_ % sizeof(T) == 0);
+            return read(samples.data(), samples.size_bytes() / frame_size_);
+        }
+
+        // the frames that can be read in place, call consume() when done with them; there may be more after the ring wraps
+        AL_HPP_NODISCARD std::span<const unsigned char> read_region() AL_HPP_NOEXCEPT {
+            al::util::spsc_ring::region readable = ring_.read_region();
+            return std::span<const unsigned char>(readable.data, readable.size - readable.size % frame_size_);
+        }
+#else
+        // the frames that can be read in place as pointer and byte count, call consume() when done with them;
+        // there may be more after the ring wraps
+        AL_HPP_NODISCARD std::pair<const unsigned char*, std::size_t> read_region() AL_HPP_NOEXCEPT {
+            al::util::spsc_ring::region readable = ring_.read_region();
+            return std::make_pair(static_cast<const unsigned char*>(readable.data), readable.size - readable.size % frame_size_);
+        }
+#endif
+        void consume(std::size_t frame_count) AL_HPP_NOEXCEPT {
+            ring_.commit_read(std::min(frame_count, available()) * frame_size_);
+        }
+
+        // frames ready to read
+        AL_HPP_NODISCARD std::size_t available() const AL_HPP_NOEXCEPT { return ring_.available() / frame_size_; }
+
+        AL_HPP_NODISCARD std::size_t overruns()   const AL_HPP_NOEXCEPT { return overruns_; }
+        AL_HPP_NODISCARD std::size_t frame_size() const AL_HPP_NOEXCEPT { return frame_size_; }
+        AL_HPP_NODISCARD al::format  format()     const AL_HPP_NOEXCEPT { return format_; }
+        AL_HPP_NODISCARD ALCuint     frequency()  const AL_HPP_NOEXCEPT { return frequency_; }
+
+        // returns non-owning pointer
+        AL_HPP_NODISCARD ALCdevice*  device_ptr() const AL_HPP_NOEXCEPT { return device_ptr_; }
+
+        // the reader thread can't throw, so it records the last ALC error it ran into; this reports it along with errors of the device
+        void check(const char* message = "") const AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            alc::errc code = last_error_.exchange(alc::errc::no_error);
+            if(code != alc::errc::no_error) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("ALC Error: " + alc::error_message(code) + " (in capture thread)" + message);
+            }
+            al::util::check_alc_error(dispatch_, device_ptr_, message);
+        }
+
+    private:
+        capture_device(const al::dispatch* capture_dispatch, const char* device_name, ALCuint frequency, al::format capture_format,
+                       ALCsizei buffer_frames, std::size_t ring_frames) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                     : dispatch_(capture_dispatch), format_(capture_format), frequency_(frequency), frame_size_(al::util::frame_size(capture_format)),
+                       ring_(ring_frames * al::util::frame_size(capture_format)), frame_(frame_size_) {
+            device_ptr_ = AL_HPP_DISPATCHED(dispatch_, alc, captureOpenDevice, alcCaptureOpenDevice)(device_name, frequency, static_cast<ALCenum>(capture_format), buffer_frames);
+            al::util::check_alc_error(dispatch_, nullptr, "(opening ALC capture device)");
+            if(device_ptr_ == nullptr) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: could not open ALC capture device!");
+                return;
+            }
+        }
+
+        void record_error() const AL_HPP_NOEXCEPT {
+            alc::errc code = static_cast<alc::errc>(AL_HPP_DISPATCHED(dispatch_, alc, getError, alcGetError)(device_ptr_));
+            if(code != alc::errc::no_error)
+                last_error_ = code;
+        }
+
+        // moves frame_count captured frames into the ring
+        void drain(std::size_t frame_count) AL_HPP_NOEXCEPT {
+            auto capture_samples = AL_HPP_DISPATCHED(dispatch_, alc, captureSamples, alcCaptureSamples);
+            while(frame_count > 0) {
+                al::util::spsc_ring::region writable = ring_.write_region();
+                std::size_t frames = std::min(frame_count, writable.size / frame_size_);
+                if(frames > 0) {
+                    capture_samples(device_ptr_, writable.data, static_cast<ALCsizei>(frames));
+                    ring_.commit_write(frames * frame_size_);
+                } else {
+                    // a frame straddles the end of the storage, so it goes through the spare frame
+                    capture_samples(device_ptr_, frame_.data(), 1);
+                    ring_.write(frame_.data(), frame_size_);
+                    frames = 1;
+                }
+                frame_count -= frames;
+            }
+        }
+
+        void run() AL_HPP_NOEXCEPT {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while(!stop_requested_) {
+                ALCint captured = 0;
+                AL_HPP_DISPATCHED(dispatch_, alc, getIntegerv, alcGetIntegerv)(device_ptr_, ALC_CAPTURE_SAMPLES, 1, &captured);
+                const std::size_t free_frames = ring_.free_space() / frame_size_;
+                if(static_cast<std::size_t>(std::max(captured, 0)) > free_frames) ++overruns_;
+                drain(std::min(static_cast<std::size_t>(std::max(captured, 0)), free_frames));
+                record_error();
+
+                wake_.wait_for(lock, poll_interval_);
+            }
+        }
+
+        void stop_thread() AL_HPP_NOEXCEPT {
+            if(!thread_.joinable()) return;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_requested_ = true;
+            }
+            wake_.notify_one();
+            thread_.join();
+        }
+
+        // owner because the device object owns a _handle_, not an allocation
+        gsl::owner<ALCdevice*> device_ptr_ = nullptr;
+        const al::dispatch* dispatch_;
+        al::format format_;
+        ALCuint frequency_;
+        std::size_t frame_size_;
+
+        al::util::spsc_ring ring_;
+        std::vector<unsigned char> frame_;
+
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::chrono::milliseconds poll_interval_ { 5 };
+        bool stop_requested_ = false;
+        std::atomic<std::size_t> overruns_ { 0 };
+        mutable std::atomic<alc::errc> last_error_ { alc::errc::no_error };
+    };
+
+
+    // Sample conversion kernels, for getting decoder output into a format the implementation takes. The vectorized paths are
+    // picked at compile time (AVX2, SSE2, NEON on AArch64), everything else and the remainders run the scalar code, which gives
+    // the same results. Floats are clamped to [-1, 1] and rounded to nearest.
+    namespace convert {
+        inline void float_to_int16(const float* in, std::int16_t* out, std::size_t count) AL_HPP_NOEXCEPT {
+            std::size_t i = 0;
+#if defined( AL_HPP_SIMD_AVX2 )
+            const __m256 scale8 = _mm256_set1_ps(32767.0f), low8 = _mm256_set1_ps(-1.0f), high8 = _mm256_set1_ps(1.0f);
+            for(; i + 16 <= count; i += 16) {
+                __m256i a = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(in + i), low8), high8), scale8));
+                __m256i b = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(in + i + 8), low8), high8), scale8));
+                // packs works per 128 bit lane, the permute puts the quarters back in order
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8));
+            }
+#endif
+#if defined( AL_HPP_SIMD_SSE2 )
+            const __m128 scale = _mm_set1_ps(32767.0f), low = _mm_set1_ps(-1.0f), high = _mm_set1_ps(1.0f);
+            for(; i + 8 <= count; i += 8) {
+                __m128i a = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i), low), high), scale));
+                __m128i b = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i + 4), low), high), scale));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(a, b));
+            }
+#elif defined( AL_HPP_SIMD_NEON )
+            const float32x4_t low = vdupq_n_f32(-1.0f), high = vdupq_n_f32(1.0f);
+            for(; i + 8 <= count; i += 8) {
+                int32x4_t a = vcvtnq_s32_f32(vmulq_n_f32(vminq_f32(vmaxq_f32(vld1q_f32(in + i), low), high), 32767.0f));
+                int32x4_t b = vcvtnq_s32_f32(vmulq_n_f32(vminq_f32(vmaxq_f32(vld1q_f32(in + i + 4), low), high), 32767.0f));
+                vst1q_s16(out + i, vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)));
+            }
+#endif
+            for(; i < count; ++i)
+                out[i] = static_cast<std::int16_t>(std::lrint(std::min(std::max(in[i], -1.0f), 1.0f) * 32767.0f));
+        }
+
+        inline void int16_to_float(const std::int16_t* in, float* out, std::size_t count) AL_HPP_NOEXCEPT {
+            std::size_t i = 0;
+#if defined( AL_HPP_SIMD_AVX2 )
+            const __m256 scale8 = _mm256_set1_ps(1.0f / 32768.0f);
+            for(; i + 8 <= count; i += 8) {
+                __m256i wide = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+                _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(wide), scale8));
+            }
+#endif
+#if defined( AL_HPP_SIMD_SSE2 )
+            const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+            for(; i + 8 <= count; i += 8) {
+                __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                // sign extension: put the samples into the upper halves and shift them down
+                __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+                __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+                _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+                _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+            }
+#elif defined( AL_HPP_SIMD_NEON )
+            for(; i + 8 <= count; i += 8) {
+                int16x8_t samples = vld1q_s16(in + i);
+                vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples))), 1.0f / 32768.0f));
+                vst1q_f32(out + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples))), 1.0f / 32768.0f));
+            }
+#endif
+            for(; i < count; ++i)
+                out[i] = static_cast<float>(in[i]) * (1.0f / 32768.0f);
+        }
+
+        // 8 bit AL samples are unsigned, silence is 128
+        inline void float_to_uint8(const float* in, std::uint8_t* out, std::size_t count) AL_HPP_NOEXCEPT {
+            std::size_t i = 0;
+#if defined( AL_HPP_SIMD_SSE2 )
+            const __m128 scale = _mm_set1_ps(127.0f), low = _mm_set1_ps(-1.0f), high = _mm_set1_ps(1.0f);
+            const __m128i offset = _mm_set1_epi16(128);
+            for(; i + 16 <= count; i += 16) {
+                __m128i q[4];
+                for(int k = 0; k < 4; ++k)
+                    q[k] = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i + 4 * k), low), high), scale));
+                __m128i first = _mm_add_epi16(_mm_packs_epi32(q[0], q[1]), offset);
+                __m128i second = _mm_add_epi16(_mm_packs_epi32(q[2], q[3]), offset);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(first, second));
+            }
+#elif defined( AL_HPP_SIMD_NEON )
+            const float32x4_t low = vdupq_n_f32(-1.0f), high = vdupq_n_f32(1.0f);
+            const int16x8_t offset = vdupq_n_s16(128);
+            for(; i + 8 <= count; i += 8) {
+                int32x4_t a = vcvtnq_s32_f32(vmulq_n_f32(vminq_f32(vmaxq_f32(vld1q_f32(in + i), low), high), 127.0f));
+                int32x4_t b = vcvtnq_s32_f32(vmulq_n_f32(vminq_f32(vmaxq_f32(vld1q_f32(in + i + 4), low), high), 127.0f));
+                vst1_u8(out + i, vqmovun_s16(vaddq_s16(vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)), offset)));
+            }
+#endif
+            for(; i < count; ++i)
+                out[i] = static_cast<std::uint8_t>(std::lrint(std::min(std::max(in[i], -1.0f), 1.0f) * 127.0f) + 128);
+        }
+
+        inline void uint8_to_float(const std::uint8_t* in, float* out, std::size_t count) AL_HPP_NOEXCEPT {
+            std::size_t i = 0;
+#if defined( AL_HPP_SIMD_SSE2 )
+            const __m128 scale = _mm_set1_ps(1.0f / 128.0f);
+            const __m128i zero = _mm_setzero_si128(), offset = _mm_set1_epi16(128);
+            for(; i + 16 <= count; i += 16) {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                __m128i halves[2] = { _mm_sub_epi16(_mm_unpacklo_epi8(bytes, zero), offset), _mm_sub_epi16(_mm_unpackhi_epi8(bytes, zero), offset) };
+                for(int k = 0; k < 2; ++k) {
+                    __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(halves[k], halves[k]), 16);
+                    __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(halves[k], halves[k]), 16);
+                    _mm_storeu_ps(out + i + 8 * k, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+                    _mm_storeu_ps(out + i + 8 * k + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+                }
+            }
+#elif defined( AL_HPP_SIMD_NEON )
+            for(; i + 8 <= count; i += 8) {
+                int16x8_t samples = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(in + i))), vdupq_n_s16(128));
+                vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples))), 1.0f / 128.0f));
+                vst1q_f32(out + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples))), 1.0f / 128.0f));
+            }
+#endif
+            for(; i < count; ++i)
+                out[i] = static_cast<float>(static_cast<int>(in[i]) - 128) * (1.0f / 128.0f);
+        }
+
+        inline void int16_to_uint8(const std::int16_t* in, std::uint8_t* out, std::size_t count) AL_HPP_NOEXCEPT {
+            std::size_t i = 0;
+#if defined( AL_HPP_SIMD_SSE2 )
+            const __m128i offset = _mm_set1_epi16(128);
+            for(; i + 16 <= count; i += 16) {
+                __m128i first = _mm_add_epi16(_mm_srai_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), 8), offset);
+                __m128i second = _mm_add_epi16(_mm_srai_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8)), 8), offset);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(first, second));
+            }
+#elif defined( AL_HPP_SIMD_NEON )
+            for(; i + 8 <= count; i += 8)
+                vst1_u8(out + i, vqmovun_s16(vaddq_s16(vshrq_n_s16(vld1q_s16(in + i), 8), vdupq_n_s16(128))));
+#endif
+            for(; i < count; ++i)
+                out[i] = static_cast<std::uint8_t>((in[i] >> 8) + 128);
+        }
+
+        inline void uint8_to_int16(const std::uint8_t* in, std::int16_t* out, std::size_t count) AL_HPP_NOEXCEPT {
+            std::size_t i = 0;
+#if defined( AL_HPP_SIMD_SSE2 )
+            const __m128i zero = _mm_setzero_si128(), offset = _mm_set1_epi16(128);
+            for(; i + 16 <= count; i += 16) {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_slli_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(bytes, zero), offset), 8));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_slli_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(bytes, zero), offset), 8));
+            }
+#elif defined( AL_HPP_SIMD_NEON )
+            for(; i + 8 <= count; i += 8)
+                vst1q_s16(out + i, vshlq_n_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(in + i))), vdupq_n_s16(128)), 8));
+#endif
+            for(; i < count; ++i)
+                out[i] = static_cast<std::int16_t>((static_cast<int>(in[i]) - 128) * 256);
+        }
+
+        // planes[c][frame] -> out[frame * channel_count + c]
+        template<typename T>
+        void interleave(const T* const* planes, std::size_t channel_count, std::size_t frames, T* out) AL_HPP_NOEXCEPT {
+            for(std::size_t c = 0; c < channel_count; ++c) {
+                const T* plane = planes[c];
+                for(std::size_t i = 0; i < frames; ++i)
+                    out[i * channel_count + c] = plane[i];
+            }
+        }
+
+        // out[c][frame] <- in[frame * channel_count + c]
+        template<typename T>
+        void deinterleave(const T* in, std::size_t channel_count, std::size_t frames, T* const* planes) AL_HPP_NOEXCEPT {
+            for(std::size_t c = 0; c < channel_count; ++c) {
+                T* plane = planes[c];
+                for(std::size_t i = 0; i < frames; ++i)
+                    plane[i] = in[i * channel_count + c];
+            }
+        }
+
+        // stereo float is the common case, it gets vector kernels
+        template<>
+        inline void interleave<float>(const float* const* planes, std::size_t channel_count, std::size_t frames, float* out) AL_HPP_NOEXCEPT {
+            if(channel_count != 2) {
+                for(std::size_t c = 0; c < channel_count; ++c)
+                    for(std::size_t i = 0; i < frames; ++i)
+                        out[i * channel_count + c] = planes[c][i];
+                return;
+            }
+            const float* left = planes[0];
+            const float* right = planes[1];
+            std::size_t i = 0;
+#if defined( AL_HPP_SIMD_SSE2 )
+            for(; i + 4 <= frames; i += 4) {
+                __m128 l = _mm_loadu_ps(left + i), r = _mm_loadu_ps(right + i);
+                _mm_storeu_ps(out + 2 * i, _mm_unpacklo_ps(l, r));
+                _mm_storeu_ps(out + 2 * i + 4, _mm_unpackhi_ps(l, r));
+            }
+#elif defined( AL_HPP_SIMD_NEON )
+            for(; i + 4 <= frames; i += 4) {
+                float32x4x2_t pair { { vld1q_f32(left + i), vld1q_f32(right + i) } };
+                vst2q_f32(out + 2 * i, pair);
+            }
+#endif
+            for(; i < frames; ++i) {
+                out[2 * i] = left[i];
+                out[2 * i + 1] = right[i];
+            }
+        }
+
+        template<>
+        inline void deinterleave<float>(const float* in, std::size_t channel_count, std::size_t frames, float* const* planes) AL_HPP_NOEXCEPT {
+            if(channel_count != 2) {
+                for(std::size_t c = 0; c < channel_count; ++c)
+                    for(std::size_t i = 0; i < frames; ++i)
+                        planes[c][i] = in[i * channel_count + c];
+                return;
+            }
+            float* left = planes[0];
+            float* right = planes[1];
+            std::size_t i = 0;
+#if defined( AL_HPP_SIMD_SSE2 )
+            for(; i + 4 <= frames; i += 4) {
+                __m128 a = _mm_loadu_ps(in + 2 * i), b = _mm_loadu_ps(in + 2 * i + 4);
+                _mm_storeu_ps(left + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+                _mm_storeu_ps(right + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+            }
+#elif defined( AL_HPP_SIMD_NEON )
+            for(; i + 4 <= frames; i += 4) {
+                float32x4x2_t pair = vld2q_f32(in + 2 * i);
+                vst1q_f32(left + i, pair.val[0]);
+                vst1q_f32(right + i, pair.val[1]);
+            }
+#endif
+            for(; i < frames; ++i) {
+                left[i] = in[2 * i];
+                right[i] = in[2 * i + 1];
+            }
+        }
+
+        // Left and right weights of every input channel for mixing the AL multichannel layouts down to stereo, in AL channel
+        // order (quad: FL FR BL BR, 5.1: FL FR FC LFE BL BR, 6.1: FL FR FC LFE BC SL SR, 7.1: FL FR FC LFE BL BR SL SR).
+        // Center and surrounds go in at -3dB, the LFE is dropped; mix() scales the result so a full scale input can't clip.
+        // nullptr for channel counts that aren't one of those layouts.
+        inline const float (*stereo_downmix(std::size_t in_channels) AL_HPP_NOEXCEPT)[2] {
+            static const float quad[4][2] = { { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.7071f, 0.0f }, { 0.0f, 0.7071f } };
+            static const float surround51[6][2] = { { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.7071f, 0.7071f }, { 0.0f, 0.0f },
+                                                    { 0.7071f, 0.0f }, { 0.0f, 0.7071f } };
+            static const float surround61[7][2] = { { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.7071f, 0.7071f }, { 0.0f, 0.0f },
+                                                    { 0.5f, 0.5f }, { 0.7071f, 0.0f }, { 0.0f, 0.7071f } };
+            static const float surround71[8][2] = { { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.7071f, 0.7071f }, { 0.0f, 0.0f },
+                                                    { 0.7071f, 0.0f }, { 0.0f, 0.7071f }, { 0.7071f, 0.0f }, { 0.0f, 0.7071f } };
+            switch(in_channels) {
+                case 4: return quad;
+                case 6: return surround51;
+                case 7: return surround61;
+                case 8: return surround71;
+            }
+            return nullptr;
+        }
+
+        // Changes the channel count of interleaved float samples. Mixing up repeats the input channels, so mono goes to every
+        // output channel and stereo to every left/right pair. Mixing down is defined for stereo to mono and for the AL
+        // multichannel layouts to stereo or mono (see stereo_downmix); returns false, without writing, for other downmixes.
+        inline bool mix(const float* in, std::size_t in_channels, float* out, std::size_t out_channels, std::size_t frames) AL_HPP_NOEXCEPT {
+            if(in_channels == out_channels) {
+                std::memmove(out, in, frames * in_channels * sizeof(float));
+                return true;
+            }
+            if(in_channels == 2 && out_channels == 1) {
+                std::size_t i = 0;
+#if defined( AL_HPP_SIMD_SSE2 )
+                const __m128 half = _mm_set1_ps(0.5f);
+                for(; i + 4 <= frames; i += 4) {
+                    __m128 a = _mm_loadu_ps(in + 2 * i), b = _mm_loadu_ps(in + 2 * i + 4);
+                    __m128 sum = _mm_add_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+                    _mm_storeu_ps(out + i, _mm_mul_ps(sum, half));
+                }
+#elif defined( AL_HPP_SIMD_NEON )
+                for(; i + 4 <= frames; i += 4) {
+                    float32x4x2_t pair = vld2q_f32(in + 2 * i);
+                    vst1q_f32(out + i, vmulq_n_f32(vaddq_f32(pair.val[0], pair.val[1]), 0.5f));
+                }
+#endif
+                for(; i < frames; ++i)
+                    out[i] = (in[2 * i] + in[2 * i + 1]) * 0.5f;
+                return true;
+            }
+            if(in_channels == 1 && out_channels == 2) {
+                std::size_t i = 0;
+#if defined( AL_HPP_SIMD_SSE2 )
+                for(; i + 4 <= frames; i += 4) {
+                    __m128 mono = _mm_loadu_ps(in + i);
+                    _mm_storeu_ps(out + 2 * i, _mm_unpacklo_ps(mono, mono));
+                    _mm_storeu_ps(out + 2 * i + 4, _mm_unpackhi_ps(mono, mono));
+                }
+#elif defined( AL_HPP_SIMD_NEON )
+                for(; i + 4 <= frames; i += 4) {
+                    float32x4_t mono = vld1q_f32(in + i);
+                    float32x4x2_t pair { { mono, mono } };
+                    vst2q_f32(out + 2 * i, pair);
+                }
+#endif
+                for(; i < frames; ++i)
+                    out[2 * i] = out[2 * i + 1] = in[i];
+                return true;
+            }
+            if(in_channels < out_channels) {
+                for(std::size_t i = 0; i < frames; ++i)
+                    for(std::size_t c = 0; c < out_channels; ++c)
+                        out[i * out_channels + c] = in[i * in_channels + c % in_channels];
+                return true;
+            }
+
+            const float (*weights)[2] = stereo_downmix(in_channels);
+            if(weights == nullptr || out_channels > 2) return false;
+            float left_sum = 0.0f;
+            for(std::size_t k = 0; k < in_channels; ++k) left_sum += weights[k][0];
+            // the layouts are symmetric, so the left sum is the loudest a channel can get
+            const float scale = 1.0f / left_sum;
+            for(std::size_t i = 0; i < frames; ++i) {
+                float left = 0.0f, right = 0.0f;
+                for(std::size_t k = 0; k < in_channels; ++k) {
+                    left += in[i * in_channels + k] * weights[k][0];
+                    right += in[i * in_channels + k] * weights[k][1];
+                }
+                if(out_channels == 2) {
+                    out[2 * i] = left * scale;
+                    out[2 * i + 1] = right * scale;
+                } else {
+                    out[i] = (left + right) * 0.5f * scale;
+                }
+            }
+            return true;
+        }
+
+        // ADPCM block layouts as OpenAL Soft reads them (AL_EXT_IMA4, AL_SOFT_MSADPCM). Both store 4 bits per sample plus a
+        // small header per block and channel, about a quarter of 16 bit PCM. block_align is in sample frames per block.
+        AL_HPP_CONST_OR_CONSTEXPR std::size_t ima4_default_block_align = 65;
+        AL_HPP_CONST_OR_CONSTEXPR std::size_t msadpcm_default_block_align = 64;
+
+        // IMA4 needs 1 + a multiple of 8 frames per block, MSADPCM an even number of at least 2
+        AL_HPP_NODISCARD AL_HPP_CONSTEXPR bool valid_block_align(al::sample_encoding encoding, std::size_t block_align) AL_HPP_NOEXCEPT {
+            return encoding == al::sample_encoding::ima4 ? block_align > 1 && (block_align - 1) % 8 == 0
+                 : encoding == al::sample_encoding::msadpcm ? block_align >= 2 && block_align % 2 == 0 : false;
+        }
+        AL_HPP_NODISCARD AL_HPP_CONSTEXPR std::size_t block_bytes(al::sample_encoding encoding, std::size_t channels, std::size_t block_align) AL_HPP_NOEXCEPT {
+            return encoding == al::sample_encoding::ima4 ? channels * (4 + (block_align - 1) / 2)
+                 : encoding == al::sample_encoding::msadpcm ? channels * (7 + (block_align - 2) / 2) : 0;
+        }
+        // bytes needed for frames frames, the last block is padded with silence
+        AL_HPP_NODISCARD AL_HPP_CONSTEXPR std::size_t compressed_bytes(al::sample_encoding encoding, std::size_t frames, std::size_t channels, std::size_t block_align) AL_HPP_NOEXCEPT {
+            return (frames + block_align - 1) / block_align * block_bytes(encoding, channels, block_align);
+        }
+
+        namespace detail {
+            AL_HPP_CONST_OR_CONSTEXPR int ima_steps[89] = {
+                    7,     8,     9,    10,    11,    12,    13,    14,    16,    17,    19,    21,    23,    25,    28,    31,
+                   34,    37,    41,    45,    50,    55,    60,    66,    73,    80,    88,    97,   107,   118,   130,   143,
+                  157,   173,   190,   209,   230,   253,   279,   307,   337,   371,   408,   449,   494,   544,   598,   658,
+                  724,   796,   876,   963,  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,
+                 3327,  3660,  4026,  4428,  4871,  5358,  5894,  6484,  7132,  7845,  8630,  9493, 10442, 11487, 12635, 13899,
+                15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+            };
+            AL_HPP_CONST_OR_CONSTEXPR int ima_index_adjust[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+            AL_HPP_CONST_OR_CONSTEXPR int msadpcm_coefficients[7][2] = {
+                { 256, 0 }, { 512, -256 }, { 0, 0 }, { 192, 64 }, { 240, 0 }, { 460, -208 }, { 392, -232 }
+            };
+            AL_HPP_CONST_OR_CONSTEXPR int msadpcm_adaption[16] = {
+                230, 230, 230, 230, 307, 409, 512, 614, 768, 614, 512, 409, 307, 230, 230, 230
+            };
+
+            AL_HPP_INLINE int clamp_sample(int sample) AL_HPP_NOEXCEPT { return std::min(std::max(sample, -32768), 32767); }
+
+            // sample i of channel c in a block, silence past the end of the input
+            AL_HPP_INLINE int block_sample(const std::int16_t* samples, std::size_t frames, std::size_t channels, std::size_t i, std::size_t c) AL_HPP_NOEXCEPT {
+                return i < frames ? samples[i * channels + c] : 0;
+            }
+
+            // quantizes one sample against the decoder's state and advances it the same way the decoder will
+            AL_HPP_INLINE int ima4_nibble(int sample, int& predictor, int& index) AL_HPP_NOEXCEPT {
+                const int step = ima_steps[index];
+                int difference = sample - predictor;
+                int code = 0;
+                if(difference < 0) {
+                    code = 8;
+                    difference = -difference;
+                }
+                // the decoder adds (2 * magnitude + 1) * step / 8
+                code |= std::min(difference * 4 / step, 7);
+                const int magnitude = (2 * (code & 7) + 1) * step / 8;
+                predictor = clamp_sample(code & 8 ? predictor - magnitude : predictor + magnitude);
+                index = std::min(std::max(index + ima_index_adjust[code & 7], 0), 88);
+                return code;
+            }
+
+            struct msadpcm_state {
+                int sample1, sample2, delta;
+            };
+
+            AL_HPP_INLINE int msadpcm_nibble(int sample, int predictor, msadpcm_state& state) AL_HPP_NOEXCEPT {
+                const int predicted = (state.sample1 * msadpcm_coefficients[predictor][0] + state.sample2 * msadpcm_coefficients[predictor][1]) / 256;
+                const int difference = sample - predicted;
+                const int rounded = difference < 0 ? difference - state.delta / 2 : difference + state.delta / 2;
+                const int code = std::min(std::max(rounded / state.delta, -8), 7);
+                state.sample2 = state.sample1;
+                state.sample1 = clamp_sample(predicted + code * state.delta);
+                state.delta = std::max(msadpcm_adaption[code & 0xF] * state.delta / 256, 16);
+                return code & 0xF;
+            }
+        }
+
+        // Encodes interleaved 16 bit samples into IMA4 blocks, out has to hold compressed_bytes(ima4, ...) bytes.
+        // Returns the number of bytes written, 0 if block_align isn't valid for IMA4.
+        inline std::size_t encode_ima4(const std::int16_t* samples, std::size_t frames, std::size_t channels, std::size_t block_align,
+                                       std::uint8_t* out) AL_HPP_NOEXCEPT {
+            if(!valid_block_align(al::sample_encoding::ima4, block_align) || channels == 0) return 0;
+            // the step index carries over from block to block, the predictor restarts from the stored sample
+            std::vector<int> indices(channels, 0);
+            std::uint8_t* block = out;
+            for(std::size_t first = 0; first < frames; first += block_align) {
+                std::vector<int> predictors(channels);
+                for(std::size_t c = 0; c < channels; ++c) {
+                    predictors[c] = detail::block_sample(samples, frames, channels, first, c);
+                    block[4 * c + 0] = static_cast<std::uint8_t>(predictors[c] & 0xFF);
+                    block[4 * c + 1] = static_cast<std::uint8_t>((predictors[c] >> 8) & 0xFF);
+                    block[4 * c + 2] = static_cast<std::uint8_t>(indices[c]);
+                    block[4 * c + 3] = 0;
+                }
+                // then 8 samples (4 bytes, low nibble first) per channel at a time
+                std::uint8_t* code = block + 4 * channels;
+                for(std::size_t i = 1; i < block_align; i += 8) {
+                    for(std::size_t c = 0; c < channels; ++c) {
+                        for(std::size_t k = 0; k < 8; k += 2) {
+                            const int low = detail::ima4_nibble(detail::block_sample(samples, frames, channels, first + i + k, c), predictors[c], indices[c]);
+                            const int high = detail::ima4_nibble(detail::block_sample(samples, frames, channels, first + i + k + 1, c), predictors[c], indices[c]);
+                            *code++ = static_cast<std::uint8_t>(low | (high << 4));
+                        }
+                    }
+                }
+                block = code;
+            }
+            return static_cast<std::size_t>(block - out);
+        }
+
+        // Encodes interleaved 16 bit samples into MSADPCM blocks, out has to hold compressed_bytes(msadpcm, ...) bytes. Each block
+        // and channel uses whichever of the seven predictors gives the smallest error.
+        // Returns the number of bytes written, 0 if block_align isn't valid for MSADPCM.
+        inline std::size_t encode_msadpcm(const std::int16_t* samples, std::size_t frames, std::size_t channels, std::size_t block_align,
+                                          std::uint8_t* out) AL_HPP_NOEXCEPT {
+            if(!valid_block_align(al::sample_encoding::msadpcm, block_align) || channels == 0) return 0;
+            std::vector<int> predictors(channels);
+            std::vector<detail::msadpcm_state> states(channels);
+            std::uint8_t* block = out;
+            for(std::size_t first = 0; first < frames; first += block_align) {
+                for(std::size_t c = 0; c < channels; ++c) {
+                    const int older = detail::block_sample(samples, frames, channels, first, c);
+                    const int newer = detail::block_sample(samples, frames, channels, first + 1, c);
+                    long long best_error = -1;
+                    for(int predictor = 0; predictor < 7; ++predictor) {
+                        // the initial step size is a quarter of the average prediction error over the first few samples
+                        const std::size_t probe_end = std::min<std::size_t>(block_align, 10);
+                        int error_sum = 0, previous = older, current = newer;
+                        for(std::size_t i = 2; i < probe_end; ++i) {
+                            const int actual = detail::block_sample(samples, frames, channels, first + i, c);
+                            error_sum += std::abs(actual - (current * detail::msadpcm_coefficients[predictor][0] + previous * detail::msadpcm_coefficients[predictor][1]) / 256);
+                            previous = current;
+                            current = actual;
+                        }
+                        const int average_error = probe_end > 2 ? error_sum / static_cast<int>(probe_end - 2) : 0;
+                        const detail::msadpcm_state start { newer, older, std::min(std::max(average_error / 4, 16), 32767) };
+
+                        // then the whole block is encoded once to see how well the predictor does
+                        detail::msadpcm_state trial = start;
+                        long long error = 0;
+                        for(std::size_t i = 2; i < block_align; ++i) {
+                            const int actual = detail::block_sample(samples, frames, channels, first + i, c);
+                            detail::msadpcm_nibble(actual, predictor, trial);
+                            error += static_cast<long long>(actual - trial.sample1) * (actual - trial.sample1);
+                        }
+                        if(best_error < 0 || error < best_error) {
+                            best_error = error;
+                            predictors[c] = predictor;
+                            states[c] = start;
+                        }
+                    }
+                }
+
+                // predictor indices, then deltas, then the second and first sample of every channel
+                std::uint8_t* header = block;
+                auto put16 = [&header](int value) {
+                    *header++ = static_cast<std::uint8_t>(value & 0xFF);
+                    *header++ = static_cast<std::uint8_t>((value >> 8) & 0xFF);
+                };
+                for(std::size_t c = 0; c < channels; ++c) *header++ = static_cast<std::uint8_t>(predictors[c]);
+                for(std::size_t c = 0; c < channels; ++c) put16(states[c].delta);
+                for(std::size_t c = 0; c < channels; ++c) put16(states[c].sample1);
+                for(std::size_t c = 0; c < channels; ++c) put16(states[c].sample2);
+
+                // nibbles run through the channels, high nibble first
+                std::uint8_t* code = header;
+                std::size_t nibble = 0;
+                for(std::size_t i = 2; i < block_align; ++i) {
+                    for(std::size_t c = 0; c < channels; ++c, ++nibble) {
+                        const int value = detail::msadpcm_nibble(detail::block_sample(samples, frames, channels, first + i, c), predictors[c], states[c]);
+                        if(nibble % 2 == 0) *code = static_cast<std::uint8_t>(value << 4);
+                        else *code++ |= static_cast<std::uint8_t>(value);
+                    }
+                }
+                block = code;
+            }
+            return static_cast<std::size_t>(block - out);
+        }
+
+        // Offline conversion of 16 bit mono or stereo samples for resident assets; upload the result with al::buffer::from.
+        // block_align 0 picks the implementation's default. Returns empty blocks for anything that can't be encoded.
+        AL_HPP_NODISCARD inline al::compressed_samples compress(const std::int16_t* samples, std::size_t frames, std::size_t channels, ALsizei frequency,
+                                                                al::sample_encoding encoding = al::sample_encoding::ima4, std::size_t block_align = 0) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            al::compressed_samples compressed;
+            const bool ima4 = encoding == al::sample_encoding::ima4;
+            if(block_align == 0) block_align = ima4 ? ima4_default_block_align : msadpcm_default_block_align;
+            if((channels != 1 && channels != 2) || !valid_block_align(encoding, block_align)) return compressed;
+
+            compressed.format = ima4 ? (channels == 1 ? al::format::mono_ima4 : al::format::stereo_ima4)
+                                     : (channels == 1 ? al::format::mono_msadpcm : al::format::stereo_msadpcm);
+            compressed.frequency = frequency;
+            compressed.block_align = static_cast<ALsizei>(block_align);
+            compressed.blocks.resize(compressed_bytes(encoding, frames, channels, block_align));
+            if(ima4) encode_ima4(samples, frames, channels, block_align, compressed.blocks.data());
+            else encode_msadpcm(samples, frames, channels, block_align, compressed.blocks.data());
+            return compressed;
+        }
+    }
+
+    namespace util {
+        // the float32 and int16 format for each channel count upload() takes, 0 where AL has none
+        AL_HPP_NODISCARD AL_HPP_CONSTEXPR al::format upload_format(std::size_t channel_count, bool float32) AL_HPP_NOEXCEPT {
+            return channel_count == 1 ? (float32 ? al::format::mono_float32 : al::format::mono16)
+                 : channel_count == 2 ? (float32 ? al::format::stereo_float32 : al::format::stereo16)
+                 : channel_count == 4 ? (float32 ? al::format::quad_float32 : al::format::quad16)
+                 : channel_count == 6 ? (float32 ? al::format::surround51_float32 : al::format::surround51_16)
+                 : channel_count == 7 ? (float32 ? al::format::surround61_float32 : al::format::surround61_16)
+                 : channel_count == 8 ? (float32 ? al::format::surround71_float32 : al::format::surround71_16)
+                 : static_cast<al::format>(0);
+        }
+
+        // Which of the upload formats the implementation takes, asked through AL_SOFT_buffer_samples if it was loaded and
+        // from the extension strings otherwise. Looked up once per dispatch and context on each thread, then kept; bit
+        // 2 * channel_count is the int16 format, the one above it the float32 one.
+        AL_HPP_NODISCARD inline std::uint32_t upload_formats(const al::dispatch* dispatch_ptr = nullptr) AL_HPP_NOEXCEPT {
+            static thread_local const al::dispatch* cached_dispatch = nullptr;
+            static thread_local ALCcontext* cached_context = nullptr;
+            static thread_local std::uint32_t cached_formats = 0;
+            ALCcontext* context_ptr = AL_HPP_DISPATCHED(dispatch_ptr, alc, getCurrentContext, alcGetCurrentContext)();
+            if(context_ptr != nullptr && context_ptr == cached_context && dispatch_ptr == cached_dispatch) return cached_formats;
+
+            LPALISBUFFERFORMATSUPPORTEDSOFT is_format_supported = AL_HPP_DISPATCHED(dispatch_ptr, al, isBufferFormatSupportedSOFT, alIsBufferFormatSupportedSOFT);
+            auto is_extension_present = AL_HPP_DISPATCHED(dispatch_ptr, al, isExtensionPresent, alIsExtensionPresent);
+            const bool float32 = context_ptr != nullptr && is_extension_present("AL_EXT_FLOAT32") == AL_TRUE;
+            const bool multichannel = context_ptr != nullptr && is_extension_present("AL_EXT_MCFORMATS") == AL_TRUE;
+            std::uint32_t formats = 0;
+            for(std::size_t channel_count = 1; channel_count <= 8; ++channel_count) {
+                for(int as_float = 0; as_float < 2; ++as_float) {
+                    const al::format candidate = upload_format(channel_count, as_float != 0);
+                    if(candidate == static_cast<al::format>(0)) continue;
+                    // 16 bit mono and stereo are core, so there's always something to fall back to
+                    bool supported = channel_count <= 2 && as_float == 0;
+                    if(is_format_supported != nullptr && context_ptr != nullptr)
+                        supported = supported || is_format_supported(candidate) == AL_TRUE;
+                    else
+                        supported = supported || ((channel_count <= 2 || multichannel) && (as_float == 0 || float32));
+                    if(supported) formats |= std::uint32_t(1) << (2 * channel_count + static_cast<std::size_t>(as_float));
+                }
+            }
+            // AL_SOFT_buffer_samples may leave an error behind for formats it doesn't know
+            AL_HPP_DISPATCHED(dispatch_ptr, al, getError, alGetError)();
+
+            cached_dispatch = dispatch_ptr;
+            cached_context = context_ptr;
+            cached_formats = formats;
+            return formats;
+        }
+
+        AL_HPP_NODISCARD AL_HPP_CONSTEXPR bool has_upload_format(std::uint32_t formats, std::size_t channel_count, bool float32) AL_HPP_NOEXCEPT {
+            return channel_count <= 8 && ((formats >> (2 * channel_count + (float32 ? 1 : 0))) & 1) != 0;
+        }
+    }
+
+    // Uploads interleaved float samples into buffer_id. If the implementation takes float32 in this channel layout, they are
+    // passed on as they are, otherwise they are converted to 16 bit. The AL multichannel layouts (4, 6, 7 or 8 channels) stay
+    // as they are when AL_EXT_MCFORMATS takes them and are only mixed down to stereo as a last resort; other channel counts
+    // above two are an error. The conversion goes through a per-thread scratch buffer, so repeated uploads don't allocate.
+    inline void upload(ALuint buffer_id, const float* samples, std::size_t frames, std::size_t channel_count, ALsizei frequency,
+                       const al::dispatch* dispatch_ptr = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        static thread_local std::vector<float> mixed;
+        static thread_local std::vector<std::int16_t> converted;
+        const std::uint32_t formats = al::util::upload_formats(dispatch_ptr);
+        if(channel_count > 2 && !al::util::has_upload_format(formats, channel_count, true) && !al::util::has_upload_format(formats, channel_count, false)) {
+            mixed.resize(frames * 2);
+            if(!al::convert::mix(samples, channel_count, mixed.data(), 2, frames)) {
+                AL_HPP_THROW_WHEN_EXCEPTIONS("Error: no stereo downmix for this channel count!");
+                return;
+            }
+            samples = mixed.data();
+            channel_count = 2;
+        }
+
+        auto buffer_data = AL_HPP_DISPATCHED(dispatch_ptr, al, bufferData, alBufferData);
+        const std::size_t count = frames * channel_count;
+        if(al::util::has_upload_format(formats, channel_count, true)) {
+            buffer_data(buffer_id, al::util::upload_format(channel_count, true), samples, static_cast<ALsizei>(count * sizeof(float)), frequency);
+        } else {
+            converted.resize(count);
+            al::convert::float_to_int16(samples, converted.data(), count);
+            buffer_data(buffer_id, al::util::upload_format(channel_count, false), converted.data(),
+                        static_cast<ALsizei>(count * sizeof(std::int16_t)), frequency);
+        }
+        al::util::check_al_error(dispatch_ptr, "(uploading buffer data)");
+    }
+
+    // like upload(), for one plane per channel
+    inline void upload_planar(ALuint buffer_id, const float* const* planes, std::size_t frames, std::size_t channel_count, ALsizei frequency,
+                              const al::dispatch* dispatch_ptr = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        static thread_local std::vector<float> interleaved;
+        interleaved.resize(frames * channel_count);
+        al::convert::interleave(planes, channel_count, frames, interleaved.data());
+        al::upload(buffer_id, interleaved.data(), frames, channel_count, frequency, dispatch_ptr);
+    }
+
+
+    namespace util {
+        // y[i] += a * x[i]
+        inline void axpy(float* y, const float* x, float a, std::size_t count) AL_HPP_NOEXCEPT {
+            std::size_t i = 0;
+#if defined( AL_HPP_SIMD_SSE2 )
+            const __m128 factor = _mm_set1_ps(a);
+            for(; i + 4 <= count; i += 4)
+                _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(_mm_loadu_ps(x + i), factor)));
+#elif defined( AL_HPP_SIMD_NEON )
+            for(; i + 4 <= count; i += 4)
+                vst1q_f32(y + i, vmlaq_n_f32(vld1q_f32(y + i), vld1q_f32(x + i), a));
+#endif
+            for(; i < count; ++i)
+                y[i] += a * x[i];
+        }
+
+        // x[i] = x[i] * a + b
+        inline void scale_offset(float* x, float a, float b, std::size_t count) AL_HPP_NOEXCEPT {
+            std::size_t i = 0;
+#if defined( AL_HPP_SIMD_SSE2 )
+            const __m128 factor = _mm_set1_ps(a), offset = _mm_set1_ps(b);
+            for(; i + 4 <= count; i += 4)
+                _mm_storeu_ps(x + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x + i), factor), offset));
+#elif defined( AL_HPP_SIMD_NEON )
+            for(; i + 4 <= count; i += 4)
+                vst1q_f32(x + i, vmlaq_n_f32(vdupq_n_f32(b), vld1q_f32(x + i), a));
+#endif
+            for(; i < count; ++i)
+                x[i] = x[i] * a + b;
+        }
+
+        // applies the row major 3x4 affine matrix m to the points (x[i], y[i], z[i]); with translate false only the 3x3 part is used
+        inline void transform_points(float* x, float* y, float* z, const float (&m)[12], bool translate, std::size_t count) AL_HPP_NOEXCEPT {
+            const float tx = translate ? m[3] : 0.0f, ty = translate ? m[7] : 0.0f, tz = translate ? m[11] : 0.0f;
+            std::size_t i = 0;
+#if defined( AL_HPP_SIMD_SSE2 )
+            const __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]);
+            const __m128 m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]), m6 = _mm_set1_ps(m[6]);
+            const __m128 m8 = _mm_set1_ps(m[8]), m9 = _mm_set1_ps(m[9]), m10 = _mm_set1_ps(m[10]);
+            const __m128 t0 = _mm_set1_ps(tx), t1 = _mm_set1_ps(ty), t2 = _mm_set1_ps(tz);
+            for(; i + 4 <= count; i += 4) {
+                const __m128 px = _mm_loadu_ps(x + i), py = _mm_loadu_ps(y + i), pz = _mm_loadu_ps(z + i);
+                _mm_storeu_ps(x + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, px), _mm_mul_ps(m1, py)), _mm_add_ps(_mm_mul_ps(m2, pz), t0)));
+                _mm_storeu_ps(y + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m4, px), _mm_mul_ps(m5, py)), _mm_add_ps(_mm_mul_ps(m6, pz), t1)));
+                _mm_storeu_ps(z + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m8, px), _mm_mul_ps(m9, py)), _mm_add_ps(_mm_mul_ps(m10, pz), t2)));
+            }
+#elif defined( AL_HPP_SIMD_NEON )
+            for(; i + 4 <= count; i += 4) {
+                const float32x4_t px = vld1q_f32(x + i), py = vld1q_f32(y + i), pz = vld1q_f32(z + i);
+                vst1q_f32(x + i, vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(tx), px, m[0]), py, m[1]), pz, m[2]));
+                vst1q_f32(y + i, vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(ty), px, m[4]), py, m[5]), pz, m[6]));
+                vst1q_f32(z + i, vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(tz), px, m[8]), py, m[9]), pz, m[10]));
+            }
+#endif
+            for(; i < count; ++i) {
+                const float px = x[i], py = y[i], pz = z[i];
+                x[i] = m[0] * px + m[1] * py + (m[2] * pz + tx);
+                y[i] = m[4] * px + m[5] * py + (m[6] * pz + ty);
+                z[i] = m[8] * px + m[9] * py + (m[10] * pz + tz);
+            }
+        }
+    }
+
+    // A fixed number of sources with their gain, pitch, position and velocity kept in parallel arrays, for updating thousands
+    // of emitters per tick. The transforms run over whole arrays with the vector kernels above; the raw arrays are available
+    // for custom ones. commit() compares every value with the one last sent and only sends the changed ones, all inside one
+    // batch. The sources are generated by the set and deleted with it; everything else (buffers, playback) goes through source_id().
+    class source_set {
+    public:
+        AL_HPP_NODISCARD explicit source_set(std::size_t count, const al::dispatch* set_dispatch = nullptr) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+                                            : dispatch_(set_dispatch), source_ids_(count) {
+            AL_HPP_DISPATCHED(dispatch_, al, genSources, alGenSources)(static_cast<ALsizei>(count), source_ids_.data());
+            al::util::check_al_error(dispatch_, "(generating source set)");
+            // start out with the AL defaults, which are also what the sources have right now
+            for(int k = 0; k < property_count; ++k) {
+                const float initial = (k == gain_values || k == pitch_values) ? 1.0f : 0.0f;
+                current_[k].assign(count, initial);
+                sent_[k].assign(count, initial);
+            }
+        }
+
+        source_set(const source_set&) = delete;
+        source_set& operator=(const source_set&) = delete;
+
+        ~source_set() AL_HPP_NOEXCEPT {
+            if(!source_ids_.empty())
+                AL_HPP_DISPATCHED(dispatch_, al, deleteSources, alDeleteSources)(static_cast<ALsizei>(source_ids_.size()), source_ids_.data());
+        }
+
+        AL_HPP_NODISCARD std::size_t size() const AL_HPP_NOEXCEPT { return source_ids_.size(); }
+        AL_HPP_NODISCARD ALuint source_id(std::size_t index) const AL_HPP_NOEXCEPT { return source_ids_[index]; }
+
+        void set_gain(std::size_t index, float value) AL_HPP_NOEXCEPT { current_[gain_values][index] = value; }
+        void set_pitch(std::size_t index, float value) AL_HPP_NOEXCEPT { current_[pitch_values][index] = value; }
+        void set_position(std::size_t index, al::vec3 value) AL_HPP_NOEXCEPT {
+            current_[position_x_values][index] = value.x;
+            current_[position_y_values][index] = value.y;
+            current_[position_z_values][index] = value.z;
+        }
+        void set_velocity(std::size_t index, al::vec3 value) AL_HPP_NOEXCEPT {
+            current_[velocity_x_values][index] = value.x;
+            current_[velocity_y_values][index] = value.y;
+            current_[velocity_z_values][index] = value.z;
+        }
+
+        AL_HPP_NODISCARD float gain(std::size_t index) const AL_HPP_NOEXCEPT { return current_[gain_values][index]; }
+        AL_HPP_NODISCARD float pitch(std::size_t index) const AL_HPP_NOEXCEPT { return current_[pitch_values][index]; }
+        AL_HPP_NODISCARD al::vec3 position(std::size_t index) const AL_HPP_NOEXCEPT {
+            return al::vec3 { current_[position_x_values][index], current_[position_y_values][index], current_[position_z_values][index] };
+        }
+        AL_HPP_NODISCARD al::vec3 velocity(std::size_t index) const AL_HPP_NOEXCEPT {
+            return al::vec3 { current_[velocity_x_values][index], current_[velocity_y_values][index], current_[velocity_z_values][index] };
+        }
+
+        // the arrays themselves, size() elements each
+        AL_HPP_NODISCARD float* gains()       AL_HPP_NOEXCEPT { return current_[gain_values].data(); }
+        AL_HPP_NODISCARD float* pitches()     AL_HPP_NOEXCEPT { return current_[pitch_values].data(); }
+        AL_HPP_NODISCARD float* positions_x() AL_HPP_NOEXCEPT { return current_[position_x_values].data(); }
+        AL_HPP_NODISCARD float* positions_y() AL_HPP_NOEXCEPT { return current_[position_y_values].data(); }
+        AL_HPP_NODISCARD float* positions_z() AL_HPP_NOEXCEPT { return current_[position_z_values].data(); }
+        AL_HPP_NODISCARD float* velocities_x() AL_HPP_NOEXCEPT { return current_[velocity_x_values].data(); }
+        AL_HPP_NODISCARD float* velocities_y() AL_HPP_NOEXCEPT { return current_[velocity_y_values].data(); }
+        AL_HPP_NODISCARD float* velocities_z() AL_HPP_NOEXCEPT { return current_[velocity_z_values].data(); }
+
+        // moves every source by offset
+        void translate(al::vec3 offset) AL_HPP_NOEXCEPT {
+            al::util::scale_offset(current_[position_x_values].data(), 1.0f, offset.x, size());
+            al::util::scale_offset(current_[position_y_values].data(), 1.0f, offset.y, size());
+            al::util::scale_offset(current_[position_z_values].data(), 1.0f, offset.z, size());
+        }
+        // position += velocity * seconds, for every source
+        void integrate(float seconds) AL_HPP_NOEXCEPT {
+            al::util::axpy(current_[position_x_values].data(), current_[velocity_x_values].data(), seconds, size());
+            al::util::axpy(current_[position_y_values].data(), current_[velocity_y_values].data(), seconds, size());
+            al::util::axpy(current_[position_z_values].data(), current_[velocity_z_values].data(), seconds, size());
+        }
+        // applies a row major 3x4 affine matrix to every position, and its 3x3 part to every velocity
+        void transform(const float (&matrix)[12]) AL_HPP_NOEXCEPT {
+            al::util::transform_points(current_[position_x_values].data(), current_[position_y_values].data(), current_[position_z_values].data(), matrix, true, size());
+            al::util::transform_points(current_[velocity_x_values].data(), current_[velocity_y_values].data(), current_[velocity_z_values].data(), matrix, false, size());
+        }
+        void scale_gains(float factor) AL_HPP_NOEXCEPT {
+            al::util::scale_offset(current_[gain_values].data(), factor, 0.0f, size());
+        }
+
+        // sends every value that changed since the last commit, returns the number of AL calls that took
+        std::size_t commit() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            auto source_float = AL_HPP_DISPATCHED(dispatch_, al, sourcef, alSourcef);
+            auto source_vector = AL_HPP_DISPATCHED(dispatch_, al, source3f, alSource3f);
+            std::size_t calls = 0;
+            al::batch commit_batch(nullptr, dispatch_);
+            for(std::size_t i = 0; i < size(); ++i) {
+                if(changed(gain_values, i)) {
+                    source_float(source_ids_[i], AL_GAIN, sent_[gain_values][i] = current_[gain_values][i]);
+                    ++calls;
+                }
+                if(changed(pitch_values, i)) {
+                    source_float(source_ids_[i], AL_PITCH, sent_[pitch_values][i] = current_[pitch_values][i]);
+                    ++calls;
+                }
+                if(changed(position_x_values, i) || changed(position_y_values, i) || changed(position_z_values, i)) {
+                    source_vector(source_ids_[i], AL_POSITION, sent_[position_x_values][i] = current_[position_x_values][i],
+                                  sent_[position_y_values][i] = current_[position_y_values][i], sent_[position_z_values][i] = current_[position_z_values][i]);
+                    ++calls;
+                }
+                if(changed(velocity_x_values, i) || changed(velocity_y_values, i) || changed(velocity_z_values, i)) {
+                    source_vector(source_ids_[i], AL_VELOCITY, sent_[velocity_x_values][i] = current_[velocity_x_values][i],
+                                  sent_[velocity_y_values][i] = current_[velocity_y_values][i], sent_[velocity_z_values][i] = current_[velocity_z_values][i]);
+                    ++calls;
+                }
+            }
+            al::util::check_al_error(dispatch_, "(committing source set)");
+            return calls;
+        }
+
+    private:
+        enum property {
+            gain_values,
+            pitch_values,
+            position_x_values,
+            position_y_values,
+            position_z_values,
+            velocity_x_values,
+            velocity_y_values,
+            velocity_z_values,
+            property_count
+        };
+
+        bool changed(int which, std::size_t index) const AL_HPP_NOEXCEPT { return current_[which][index] != sent_[which][index]; }
+
+        const al::dispatch* dispatch_;
+        std::vector<ALuint> source_ids_;
+        // what the application set, and what AL was last told
+        std::vector<float> current_[property_count];
+        std::vector<float> sent_[property_count];
+    };
+
+
+    // Hands out AL names of one kind (see al::traits) from blocks generated with a single gen call each. Released names are
+    // reset and kept on a free list for the next acquire, and everything the pool ever generated is deleted with a single
+    // delete call in clear() or the destructor, including names that are still handed out.
+    // Not thread safe, and the context the names belong to has to be current for every call.
+    template<typename Kind>
+    class name_pool {
+    public:
+        AL_HPP_NODISCARD explicit name_pool(std::size_t block_size = 64, const al::dispatch* pool_dispatch = nullptr) AL_HPP_NOEXCEPT
+                                           : dispatch_{pool_dispatch}, block_size_{block_size > 0 ? block_size : 1} {}
+
+        name_pool(const name_pool&) = delete;
+        name_pool& operator=(const name_pool&) = delete;
+
+        ~name_pool() AL_HPP_NOEXCEPT { clear(); }
+
+        // returns 0 if no more names could be generated
+        AL_HPP_NODISCARD ALuint acquire() AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(free_.empty()) {
+                ++misses_;
+                grow(block_size_);
+                if(free_.empty()) return 0;
+            } else {
+                ++hits_;
+            }
+            ALuint name = free_.back();
+            free_.pop_back();
+            in_use(1);
+            return name;
+        }
+        // fills names with count names, generating at most one new block; returns how many could be acquired
+        std::size_t acquire(ALuint* names, std::size_t count) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(free_.size() < count) {
+                ++misses_;
+                grow(std::max(block_size_, count - free_.size()));
+            } else {
+                ++hits_;
+            }
+            const std::size_t acquired = std::min(count, free_.size());
+            std::copy(free_.end() - static_cast<std::ptrdiff_t>(acquired), free_.end(), names);
+            free_.resize(free_.size() - acquired);
+            in_use(acquired);
+            return acquired;
+        }
+
+        // the name must have come from this pool
+        void release(ALuint name) AL_HPP_NOEXCEPT {
+            if(name == 0) return;
+            Kind::reset(dispatch_, name);
+            free_.push_back(name);
+            --in_use_;
+        }
+        void release(const ALuint* names, std::size_t count) AL_HPP_NOEXCEPT {
+            for(std::size_t i = 0; i < count; ++i)
+                release(names[i]);
+        }
+
+        // makes sure at least count names can be acquired without generating more
+        void reserve(std::size_t count) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            if(free_.size() < count) grow(count - free_.size());
+        }
+
+        // deletes every name the pool generated
+        void clear() AL_HPP_NOEXCEPT {
+            if(!names_.empty())
+                Kind::destroy(dispatch_, static_cast<ALsizei>(names_.size()), names_.data());
+            names_.clear();
+            free_.clear();
+            in_use_ = 0;
+        }
+
+        AL_HPP_NODISCARD std::size_t block_size() const AL_HPP_NOEXCEPT { return block_size_; }
+        AL_HPP_NODISCARD std::size_t capacity()   const AL_HPP_NOEXCEPT { return names_.size(); }
+        AL_HPP_NODISCARD std::size_t available()  const AL_HPP_NOEXCEPT { return free_.size(); }
+        AL_HPP_NODISCARD std::size_t in_use()     const AL_HPP_NOEXCEPT { return in_use_; }
+        // most names handed out at the same time
+        AL_HPP_NODISCARD std::size_t high_water() const AL_HPP_NOEXCEPT { return high_water_; }
+        // acquires served from the free list, and acquires that had to generate a block
+        AL_HPP_NODISCARD std::size_t hits()       const AL_HPP_NOEXCEPT { return hits_; }
+        AL_HPP_NODISCARD std::size_t misses()     const AL_HPP_NOEXCEPT { return misses_; }
+        AL_HPP_NODISCARD std::size_t blocks()     const AL_HPP_NOEXCEPT { return blocks_; }
+
+    private:
+        void grow(std::size_t count) AL_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+            // generated aside, so a failed (or throwing) check can't leave invalid names in names_ for clear() to delete
+            std::vector<ALuint> block(count);
+            Kind::generate(dispatch_, static_cast<ALsizei>(count), block.data());
+            if(al::util::check_al_error(dispatch_, "(generating pooled names)") != al::no_error) return;
+            names_.insert(names_.end(), block.begin(), block.end());
+            // reversed so the lowest names are handed out first
+            free_.insert(free_.begin(), block.rbegin(), block.rend());
+            ++blocks_;
+        }
+
+        void in_use(std::size_t acquired) AL_HPP_NOEXCEPT {
+            in_use_ += acquired;
+            high_water_ = std::max(high_water_, in_use_);
+        }
+
+        const al::dispatch* dispatch_;
+        std::size_t block_size_;
+        // every name ever generated, in generation order
+        std::vector<ALuint> names_;
+        // back is acquired next
+        std::vector<ALuint> free_;
+        std::size_t in_use_ = 0, high_water_ = 0;
+        std::size_t hits_ = 0, misses_ = 0, blocks_ = 0;
+    };
+
 } // namespace al
 
 #endif
@@ -0,0 +1,216 @@
+/*
+ * al_bench.cpp - headless benchmarks for al.hpp, rendering through an ALC_SOFT_loopback device so no sound card is needed.
+ * Prints one JSON object per line, so results of different al.hpp revisions can be collected and compared by a script.
+ *
+ * Build (with the same include paths al.hpp needs), e.g.:
+ *     c++ -std=c++17 -O2 -I.. -I<openal include dir> al_bench.cpp -o al_bench -ldl -pthread
+ * Run:
+ *     ./al_bench [iterations] > bench_output.txt
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+ */
+
+#include "al.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+
+namespace {
+    using bench_clock = std::chrono::steady_clock;
+
+    // one result line: {"revision":...,"benchmark":"...","parameter":...,"iterations":...,"ns_per_op":...,"extra_name":extra}
+    void report(const char* benchmark, long long parameter, std::size_t iterations, bench_clock::duration elapsed,
+                const char* extra_name = nullptr, double extra = 0.0) {
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        std::printf("{\"revision\":%ld,\"benchmark\":\"%s\",\"parameter\":%lld,\"iterations\":%zu,\"ns_per_op\":%.3f",
+                    AL_HPP_REVISION, benchmark, parameter, iterations, ns / static_cast<double>(iterations));
+        if(extra_name != nullptr)
+            std::printf(",\"%s\":%.3f", extra_name, extra);
+        std::printf("}\n");
+        std::fflush(stdout);
+    }
+
+    template<typename F>
+    bench_clock::duration time(F&& body) {
+        auto start = bench_clock::now();
+        body();
+        return bench_clock::now() - start;
+    }
+
+    void bench_source_lifetime(std::size_t iterations) {
+        auto elapsed = time([&] {
+            for(std::size_t i = 0; i < iterations; ++i) {
+                ALuint source_id = 0;
+                al::genSources(1, &source_id);
+                al::deleteSources(1, &source_id);
+            }
+        });
+        report("source_gen_delete", 1, iterations, elapsed);
+
+        // the same amount of names in a single call
+        std::vector<ALuint> source_ids(256);
+        std::size_t rounds = std::max<std::size_t>(1, iterations / source_ids.size());
+        elapsed = time([&] {
+            for(std::size_t i = 0; i < rounds; ++i) {
+                al::genSources(static_cast<ALsizei>(source_ids.size()), source_ids.data());
+                al::deleteSources(static_cast<ALsizei>(source_ids.size()), source_ids.data());
+            }
+        });
+        report("source_gen_delete", static_cast<long long>(source_ids.size()), rounds * source_ids.size(), elapsed);
+    }
+
+    void bench_setters(std::size_t iterations) {
+        ALuint source_id = 0;
+        al::genSources(1, &source_id);
+
+        auto elapsed = time([&] {
+            for(std::size_t i = 0; i < iterations; ++i)
+                al::sourcef(source_id, AL_GAIN, static_cast<float>(i & 1));
+        });
+        report("sourcef_unchecked", 0, iterations, elapsed);
+
+        elapsed = time([&] {
+            for(std::size_t i = 0; i < iterations; ++i) {
+                al::sourcef(source_id, AL_GAIN, static_cast<float>(i & 1));
+                al::check_error();
+            }
+        });
+        report("sourcef_checked", 0, iterations, elapsed);
+
+        elapsed = time([&] {
+            for(std::size_t i = 0; i < iterations; ++i)
+                al::source3f(source_id, AL_POSITION, static_cast<float>(i), 0.0f, 1.0f);
+        });
+        report("source3f_unchecked", 0, iterations, elapsed);
+
+        elapsed = time([&] {
+            for(std::size_t i = 0; i < iterations; ++i) {
+                al::source3f(source_id, AL_POSITION, static_cast<float>(i), 0.0f, 1.0f);
+                al::check_error();
+            }
+        });
+        report("source3f_checked", 0, iterations, elapsed);
+
+        al::deleteSources(1, &source_id);
+    }
+
+    void bench_uploads(std::size_t iterations) {
+        const std::size_t size = 1 << 20;
+        std::vector<unsigned char> data(size);
+        for(std::size_t i = 0; i < size; ++i)
+            data[i] = static_cast<unsigned char>(i * 31);
+
+        const al::format formats[] = { al::format::mono8, al::format::mono16, al::format::stereo8, al::format::stereo16 };
+        ALuint buffer_id = 0;
+        al::genBuffers(1, &buffer_id);
+        std::size_t rounds = std::max<std::size_t>(1, iterations / 1000);
+        for(al::format data_format : formats) {
+            auto elapsed = time([&] {
+                for(std::size_t i = 0; i < rounds; ++i)
+                    al::bufferData(buffer_id, data_format, data.data(), static_cast<ALsizei>(size), 48000);
+            });
+            double seconds = std::chrono::duration<double>(elapsed).count();
+            report("buffer_upload", static_cast<long long>(data_format), rounds, elapsed,
+                   "mb_per_s", static_cast<double>(size * rounds) / (1024.0 * 1024.0) / seconds);
+        }
+        al::deleteBuffers(1, &buffer_id);
+        al::check_error();
+    }
+
+    void bench_streaming(al::loopback_device& loopback, std::size_t iterations) {
+        const std::size_t buffer_count = 4, buffer_frames = 1024;
+        std::vector<short> samples(buffer_frames, 0);
+        std::vector<ALuint> buffer_ids(buffer_count);
+        std::vector<float> output(buffer_frames * 2);
+        ALuint source_id = 0;
+        al::genSources(1, &source_id);
+        al::genBuffers(static_cast<ALsizei>(buffer_count), buffer_ids.data());
+        for(ALuint buffer_id : buffer_ids)
+            al::bufferData(buffer_id, al::format::mono16, samples.data(), static_cast<ALsizei>(samples.size() * sizeof(short)), 48000);
+        al::sourceQueueBuffers(source_id, static_cast<ALsizei>(buffer_count), buffer_ids.data());
+        al::sourcePlay(source_id);
+
+        // every cycle renders one buffer worth of audio, then requeues whatever was processed
+        std::size_t rounds = std::max<std::size_t>(1, iterations / 100);
+        auto elapsed = time([&] {
+            for(std::size_t i = 0; i < rounds; ++i) {
+                loopback.render(output.data(), buffer_frames);
+                ALint processed = 0;
+                al::getSourcei(source_id, AL_BUFFERS_PROCESSED, &processed);
+                while(processed-- > 0) {
+                    ALuint buffer_id = 0;
+                    al::sourceUnqueueBuffers(source_id, 1, &buffer_id);
+                    al::bufferData(buffer_id, al::format::mono16, samples.data(), static_cast<ALsizei>(samples.size() * sizeof(short)), 48000);
+                    al::sourceQueueBuffers(source_id, 1, &buffer_id);
+                }
+            }
+        });
+        report("stream_cycle", static_cast<long long>(buffer_frames), rounds, elapsed);
+
+        al::sourceStop(source_id);
+        al::deleteSources(1, &source_id);
+        al::deleteBuffers(static_cast<ALsizei>(buffer_count), buffer_ids.data());
+        al::check_error();
+    }
+
+    void bench_render(al::loopback_device& loopback) {
+        const std::size_t frequency = static_cast<std::size_t>(loopback.format().frequency);
+        const std::size_t block_frames = 1024;
+        std::vector<short> tone(frequency);
+        for(std::size_t i = 0; i < tone.size(); ++i)
+            tone[i] = static_cast<short>(8000.0 * std::sin(static_cast<double>(i) * 0.05));
+
+        ALuint buffer_id = 0;
+        al::genBuffers(1, &buffer_id);
+        al::bufferData(buffer_id, al::format::mono16, tone.data(), static_cast<ALsizei>(tone.size() * sizeof(short)), static_cast<ALsizei>(frequency));
+
+        std::vector<char> output(block_frames * loopback.frame_size());
+        std::vector<ALuint> source_ids;
+        for(std::size_t active : { 0, 1, 16, 64, 128, 255 }) {
+            while(source_ids.size() < active) {
+                ALuint source_id = 0;
+                al::genSources(1, &source_id);
+                if(al::getError() != AL_NO_ERROR) break;
+                al::sourcei(source_id, AL_BUFFER, static_cast<ALint>(buffer_id));
+                al::sourcei(source_id, AL_LOOPING, AL_TRUE);
+                al::source3f(source_id, AL_POSITION, static_cast<float>(source_ids.size() % 7) - 3.0f, 0.0f, -1.0f);
+                al::sourcePlay(source_id);
+                source_ids.push_back(source_id);
+            }
+
+            // one second of audio per measurement
+            std::size_t blocks = frequency / block_frames;
+            auto elapsed = time([&] {
+                for(std::size_t i = 0; i < blocks; ++i)
+                    loopback.render(output.data(), block_frames);
+            });
+            double seconds = std::chrono::duration<double>(elapsed).count();
+            report("render_samples", static_cast<long long>(source_ids.size()), blocks, elapsed,
+                   "realtime_factor", static_cast<double>(blocks * block_frames) / static_cast<double>(frequency) / seconds);
+        }
+
+        al::sourceStopv(static_cast<ALsizei>(source_ids.size()), source_ids.data());
+        al::deleteSources(static_cast<ALsizei>(source_ids.size()), source_ids.data());
+        al::deleteBuffers(1, &buffer_id);
+        al::check_error();
+    }
+}
+
+
+int main(int argc, char** argv) {
+    std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+
+    al::load();
+    al::loopback_device loopback { { 48000, al::loopback_device::channels::stereo, al::loopback_device::sample_type::float32 } };
+    al::listener bench_listener { loopback, loopback.attributes().data() };
+    al::update(loopback.device_ptr());
+
+    bench_source_lifetime(iterations);
+    bench_setters(iterations);
+    bench_uploads(iterations);
+    bench_streaming(loopback, iterations);
+    bench_render(loopback);
+    return 0;
+}